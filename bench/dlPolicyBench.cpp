@@ -0,0 +1,555 @@
+//=============================================================================
+//
+//  Copyright (c) 2004. Riccardo Riedl (www.riccardo-riedl.de)
+//
+//  Permission to use, copy, modify, distribute and sell this software and its
+//  documentation for any purpose is hereby granted without fee, provided that
+//  the above copyright notice appears in all copies and that both that
+//  copyright notice and this permission notice appear in supporting
+//  documentation.
+//
+//  There are no representations made about the suitability of this software
+//  for any purpose. It is provided "as is" without expressed or implied
+//  warranty.
+//
+//=============================================================================
+
+
+//=============================================================================
+//  dlPolicyBench
+//
+//  description:    calls every methode separately in batches on CdlList and
+//                  on every policy combination of CdlPolicyList and reports
+//                  the retired instructions and the time per call. the
+//                  instructions are counted by the hardware counter of
+//                  perf_event_open() on linux. where that is not available,
+//                  only the time is reported. the allocator share of the
+//                  Add and Delete methodes is measured on its own and
+//                  subtracted.
+//
+//  usage:          dlPolicyBench [calls]
+//=============================================================================
+
+
+//=============================================================================
+//  preprocessor directives
+//=============================================================================
+
+#include "dlList.h"
+#include "dlPolicyList.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif  //  __linux__
+
+//  number of elements the list holds between the batches
+//
+#define DL_BENCH_SIZE   ( 64 )
+
+//  number of calls of one methode in a counted region
+//
+#define DL_BENCH_BATCH  ( 256 )
+
+//  number of measured list types
+//
+#define DL_BENCH_LISTS  ( 5 )
+
+
+//=============================================================================
+//  CdlInstructionCounter class
+//
+//  description:    counts the instructions retired in user mode by the
+//                  calling thread between Start() and Stop()
+//=============================================================================
+
+class CdlInstructionCounter
+{
+private:
+
+    int m_nFile;    //  the perf event, -1 if not available
+
+public:
+
+    CdlInstructionCounter(void);
+    ~CdlInstructionCounter(void);
+
+    bool IsAvailable(void) const { return (-1 != m_nFile); }
+
+    void               Start(void);
+    unsigned long long Stop (void);
+};
+
+
+CdlInstructionCounter::CdlInstructionCounter(void)
+    : m_nFile (-1)
+{
+#ifdef __linux__
+
+    struct perf_event_attr attr;
+
+    memset( &attr, 0, sizeof(attr) );
+    attr.size           = sizeof(attr);
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.config         = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+
+    m_nFile = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+
+#endif  //  __linux__
+}
+
+
+CdlInstructionCounter::~CdlInstructionCounter(void)
+{
+#ifdef __linux__
+
+    if (true == IsAvailable())
+    {
+        close(m_nFile);
+    }
+
+#endif  //  __linux__
+}
+
+
+void CdlInstructionCounter::Start(void)
+{
+#ifdef __linux__
+
+    if (true == IsAvailable())
+    {
+        ioctl(m_nFile, PERF_EVENT_IOC_RESET,  0);
+        ioctl(m_nFile, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+#endif  //  __linux__
+}
+
+
+unsigned long long CdlInstructionCounter::Stop(void)
+{
+    unsigned long long nCount = 0ULL;
+
+#ifdef __linux__
+
+    if (true == IsAvailable())
+    {
+        ioctl(m_nFile, PERF_EVENT_IOC_DISABLE, 0);
+
+        if (sizeof(nCount) != read(m_nFile, &nCount, sizeof(nCount)))
+        {
+            nCount = 0ULL;
+        }
+    }
+
+#endif  //  __linux__
+
+    return nCount;
+}
+
+
+//=============================================================================
+//  benchmark
+//-----------------------------------------------------------------------------
+
+//  the measured operations, one row of the result for each
+//
+enum DL_BENCHOP
+{
+    DL_BENCH_ADDAFTER,
+    DL_BENCH_ADDBEFORE,
+    DL_BENCH_DELETEAT,
+    DL_BENCH_DELETEFIRST,
+    DL_BENCH_DELETELAST,
+    DL_BENCH_GETNEXT,
+    DL_BENCH_GETAT,
+    DL_BENCH_SETAT,
+
+    DL_BENCH_OPCOUNT
+};
+
+static const char* const g_aszBenchNames[DL_BENCH_OPCOUNT] =
+{
+    "AddAfter", "AddBefore", "DeleteAt", "DeleteFirst", "DeleteLast",
+    "GetNextPosition", "GetAt", "SetAt"
+};
+
+
+//  keeps the results of the reading operations alive
+//
+static volatile long g_nSink = 0L;
+
+
+//  returns a monotonic time stamp in nanoseconds
+//
+static unsigned long long Now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return static_cast<unsigned long long>(now.tv_sec) * 1000000000ULL + now.tv_nsec;
+}
+
+
+//  sums up the instructions of the counted regions of one operation and
+//  keeps the time of the fastest one, which is the least disturbed by the
+//  allocator and by interrupts. everything between the batches, like
+//  preparing the list for the next batch, is not counted.
+//
+class CdlSample
+{
+private:
+
+    CdlInstructionCounter& m_counter;
+    unsigned long long     m_nInstructions;
+    unsigned long long     m_nBatches;
+    unsigned long long     m_nBest;
+    unsigned long long     m_nStart;
+
+public:
+
+    CdlSample(CdlInstructionCounter& counter)
+        : m_counter(counter), m_nInstructions(0ULL), m_nBatches(0ULL), m_nBest(0ULL), m_nStart(0ULL) { ; }
+
+    void Start(void)
+    {
+        m_nStart = Now();
+        m_counter.Start();
+    }
+
+    void Stop(void)
+    {
+        m_nInstructions += m_counter.Stop();
+
+        unsigned long long nTime = Now() - m_nStart;
+
+        m_nBest = ( (0ULL == m_nBatches++) || (nTime < m_nBest) ) ? nTime : m_nBest;
+    }
+
+    double GetInstructions(void) const { return m_nInstructions / (static_cast<double>(m_nBatches) * DL_BENCH_BATCH); }
+    double GetTime        (void) const { return m_nBest / static_cast<double>(DL_BENCH_BATCH); }
+};
+
+
+//  the allocator share of the Add and Delete methodes. it is measured with
+//  bare calls of operator new and operator delete of the node size in the
+//  same batches and subtracted, so that the rows show the work of the list
+//  itself. CdlNode<long> and CdlPolicyNode<long> have the same size.
+//
+static void MeasureNew(CdlSample& sample, unsigned long nBatches)
+{
+    void* apNodes[DL_BENCH_BATCH];
+
+    for (unsigned long nBatch = 0; nBatch < nBatches; nBatch++)
+    {
+        sample.Start();
+
+        for (int nOp = 0; nOp < DL_BENCH_BATCH; nOp++)
+        {
+            apNodes[nOp] = ::operator new(sizeof(CdlNode<long>));
+        }
+
+        sample.Stop();
+
+        for (int nOp = 0; nOp < DL_BENCH_BATCH; nOp++)
+        {
+            g_nSink = g_nSink + (0 != apNodes[nOp]);
+            ::operator delete(apNodes[nOp]);
+        }
+    }
+}
+
+static void MeasureDelete(CdlSample& sample, unsigned long nBatches)
+{
+    void* apNodes[DL_BENCH_BATCH];
+
+    for (unsigned long nBatch = 0; nBatch < nBatches; nBatch++)
+    {
+        for (int nOp = 0; nOp < DL_BENCH_BATCH; nOp++)
+        {
+            apNodes[nOp] = ::operator new(sizeof(CdlNode<long>));
+            g_nSink = g_nSink + (0 != apNodes[nOp]);
+        }
+
+        sample.Start();
+
+        for (int nOp = 0; nOp < DL_BENCH_BATCH; nOp++)
+        {
+            ::operator delete(apNodes[nOp]);
+        }
+
+        sample.Stop();
+    }
+}
+
+
+//  runs 'nBatches' batches of one operation on a list of DL_BENCH_SIZE
+//  elements. the Add methodes are undone and the Delete methodes are
+//  prepared outside the counted region. all positions are valid and the
+//  list is never empty, which makes it legal for DL_UNCHECKED as well.
+//
+template <class LIST>
+void MeasureOp(DL_BENCHOP nOp, LIST& list, CdlSample& sample, unsigned long nBatches)
+{
+    DL_POSITION aPositions[DL_BENCH_BATCH];
+    DL_POSITION aElements [DL_BENCH_SIZE];
+    long        nValue = 0L;
+    long        nSum   = 0L;
+    int         nCount = 0;
+
+    for (DL_POSITION position = list.GetFirstPosition(); 0 != position; position = list.GetNextPosition(position))
+    {
+        aElements[nCount++] = position;
+    }
+
+    const DL_POSITION middle = aElements[DL_BENCH_SIZE / 2];
+
+    for (unsigned long nBatch = 0; nBatch < nBatches; nBatch++)
+    {
+        switch (nOp)
+        {
+            case DL_BENCH_ADDAFTER:
+            case DL_BENCH_ADDBEFORE:
+
+                sample.Start();
+
+                for (int nIndex = 0; nIndex < DL_BENCH_BATCH; nIndex++)
+                {
+                    aPositions[nIndex] = (DL_BENCH_ADDAFTER == nOp)
+                        ? list.AddAfter (nIndex, middle)
+                        : list.AddBefore(nIndex, middle);
+                }
+
+                sample.Stop();
+
+                for (int nIndex = 0; nIndex < DL_BENCH_BATCH; nIndex++)
+                {
+                    list.DeleteAt(aPositions[nIndex]);
+                }
+
+                break;
+
+            case DL_BENCH_DELETEAT:
+
+                for (int nIndex = 0; nIndex < DL_BENCH_BATCH; nIndex++)
+                {
+                    aPositions[nIndex] = list.AddAfter(nIndex, middle);
+                }
+
+                sample.Start();
+
+                for (int nIndex = 0; nIndex < DL_BENCH_BATCH; nIndex++)
+                {
+                    list.DeleteAt(aPositions[nIndex]);
+                }
+
+                sample.Stop();
+                break;
+
+            case DL_BENCH_DELETEFIRST:
+            case DL_BENCH_DELETELAST:
+
+                //  the added elements are in front of the original ones
+                //  at the end, where they are deleted from
+                //
+                for (int nIndex = 0; nIndex < DL_BENCH_BATCH; nIndex++)
+                {
+                    (DL_BENCH_DELETEFIRST == nOp)
+                        ? list.AddFirst(nIndex)
+                        : list.AddLast (nIndex);
+                }
+
+                sample.Start();
+
+                for (int nIndex = 0; nIndex < DL_BENCH_BATCH; nIndex++)
+                {
+                    (DL_BENCH_DELETEFIRST == nOp)
+                        ? list.DeleteFirst()
+                        : list.DeleteLast ();
+                }
+
+                sample.Stop();
+                break;
+
+            case DL_BENCH_GETNEXT:
+
+                sample.Start();
+
+                for (int nWalk = 0; nWalk < DL_BENCH_BATCH / DL_BENCH_SIZE; nWalk++)
+                {
+                    DL_POSITION position = list.GetFirstPosition();
+
+                    for (int nStep = 1; nStep < DL_BENCH_SIZE; nStep++)
+                    {
+                        position = list.GetNextPosition(position);
+                    }
+
+                    nSum += (0 != list.GetNextPosition(position));
+                }
+
+                sample.Stop();
+                break;
+
+            case DL_BENCH_GETAT:
+
+                sample.Start();
+
+                for (int nIndex = 0; nIndex < DL_BENCH_BATCH; nIndex++)
+                {
+                    list.GetAt(nValue, aElements[nIndex % DL_BENCH_SIZE]);
+                    nSum += nValue;
+                }
+
+                sample.Stop();
+                break;
+
+            case DL_BENCH_SETAT:
+
+                sample.Start();
+
+                for (int nIndex = 0; nIndex < DL_BENCH_BATCH; nIndex++)
+                {
+                    list.SetAt(nIndex, aElements[nIndex % DL_BENCH_SIZE]);
+                }
+
+                sample.Stop();
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    g_nSink = g_nSink + nSum;
+}
+
+
+//  measures every operation on one list type. 'adBase' holds the
+//  allocator share per operation of the Add and the Delete methodes.
+//
+template <class LIST>
+void Measure(double adResults[DL_BENCH_OPCOUNT][2], CdlInstructionCounter& counter,
+             unsigned long nBatches, const double adBase[2][2])
+{
+    LIST list;
+
+    for (long nValue = 0; nValue < DL_BENCH_SIZE; nValue++)
+    {
+        list.AddLast(nValue);
+    }
+
+    for (int nOp = 0; nOp < DL_BENCH_OPCOUNT; nOp++)
+    {
+        CdlSample warm  (counter);
+        CdlSample sample(counter);
+
+        //  one short run to get the caches and the allocator warm
+        //
+        MeasureOp(static_cast<DL_BENCHOP>(nOp), list, warm,   nBatches / 10 + 1);
+        MeasureOp(static_cast<DL_BENCHOP>(nOp), list, sample, nBatches);
+
+        const double* pdBase = (nOp <= DL_BENCH_ADDBEFORE) ? adBase[0]
+                             : (nOp <= DL_BENCH_DELETELAST) ? adBase[1]
+                             : 0;
+
+        adResults[nOp][0] = sample.GetInstructions() - ( (0 != pdBase) ? pdBase[0] : 0.0 );
+        adResults[nOp][1] = sample.GetTime()         - ( (0 != pdBase) ? pdBase[1] : 0.0 );
+    }
+}
+
+
+//  measures the allocator share for the Add and the Delete methodes
+//
+static void MeasureBase(double adBase[2][2], CdlInstructionCounter& counter, unsigned long nBatches)
+{
+    CdlSample warm        (counter);
+    CdlSample sampleNew   (counter);
+    CdlSample sampleDelete(counter);
+
+    MeasureNew   (warm,         nBatches / 10 + 1);
+    MeasureNew   (sampleNew,    nBatches);
+    MeasureDelete(sampleDelete, nBatches);
+
+    adBase[0][0] = sampleNew.GetInstructions();
+    adBase[0][1] = sampleNew.GetTime();
+    adBase[1][0] = sampleDelete.GetInstructions();
+    adBase[1][1] = sampleDelete.GetTime();
+}
+
+
+int main(int argc, char* argv[])
+{
+    unsigned long nOps = (argc > 1)
+        ? strtoul(argv[1], 0, 10)
+        : 1000000UL;
+
+    const unsigned long nBatches = (nOps + DL_BENCH_BATCH - 1) / DL_BENCH_BATCH;
+
+    static const char* const aszLists[DL_BENCH_LISTS] =
+    {
+        "CdlList",
+        "CdlPolicyList<DL_CHECKED,   DL_COUNTED>",
+        "CdlPolicyList<DL_CHECKED,   DL_UNCOUNTED>",
+        "CdlPolicyList<DL_UNCHECKED, DL_COUNTED>",
+        "CdlPolicyList<DL_UNCHECKED, DL_UNCOUNTED>"
+    };
+
+    CdlInstructionCounter counter;
+    double                adBase[2][2];
+    double                adResults[DL_BENCH_LISTS][DL_BENCH_OPCOUNT][2];
+
+    MeasureBase(adBase, counter, nBatches);
+
+    Measure< CdlList<long> >                                   (adResults[0], counter, nBatches, adBase);
+    Measure< CdlPolicyList<long, DL_CHECKED,   DL_COUNTED>   > (adResults[1], counter, nBatches, adBase);
+    Measure< CdlPolicyList<long, DL_CHECKED,   DL_UNCOUNTED> > (adResults[2], counter, nBatches, adBase);
+    Measure< CdlPolicyList<long, DL_UNCHECKED, DL_COUNTED>   > (adResults[3], counter, nBatches, adBase);
+    Measure< CdlPolicyList<long, DL_UNCHECKED, DL_UNCOUNTED> > (adResults[4], counter, nBatches, adBase);
+
+    printf("%lu calls of every methode on %d elements\n", nBatches * DL_BENCH_BATCH, DL_BENCH_SIZE);
+
+    if (false == counter.IsAvailable())
+    {
+        printf("the instruction counter is not available, only the time is measured\n");
+    }
+
+    printf("subtracted from the Add methodes (operator new):    %8.1f instr %8.2f ns\n", adBase[0][0], adBase[0][1]);
+    printf("subtracted from the Delete methodes (operator delete): %5.1f instr %8.2f ns\n", adBase[1][0], adBase[1][1]);
+
+    printf("\n%-16s %-42s %10s %10s\n", "methode", "list", "instr/op", "ns/op");
+
+    for (int nOp = 0; nOp < DL_BENCH_OPCOUNT; nOp++)
+    {
+        for (int nList = 0; nList < DL_BENCH_LISTS; nList++)
+        {
+            if (true == counter.IsAvailable())
+            {
+                printf("%-16s %-42s %10.1f %10.2f\n", g_aszBenchNames[nOp], aszLists[nList],
+                       adResults[nList][nOp][0], adResults[nList][nOp][1]);
+            }
+
+            else
+            {
+                printf("%-16s %-42s %10s %10.2f\n", g_aszBenchNames[nOp], aszLists[nList],
+                       "n/a", adResults[nList][nOp][1]);
+            }
+        }
+
+        printf("\n");
+    }
+
+    return 0;
+}
+
+//  end of file
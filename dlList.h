@@ -28,6 +28,10 @@
 //
 #include <string.h>
 
+//  header file for placement new and std::nothrow
+//
+#include <new>
+
 //  symbol for null-pointer
 //
 #define DL_NULL ( static_cast< CdlNode<DATATYPE>* >( 0 ) )
@@ -47,6 +51,16 @@ typedef struct _DL_POSITION_
 * DL_POSITION;
 
 
+//=============================================================================
+//  DL_REMAP type definition
+//
+//  description:    callback to report the new position of an element that
+//                  has been moved to another node by CdlList::Compact()
+//=============================================================================
+
+typedef void (*DL_REMAP)(DL_POSITION oldPosition, DL_POSITION newPosition, void* pContext);
+
+
 //=============================================================================
 //  CdlNode template class
 //
@@ -164,6 +178,22 @@ private:
 
     unsigned long m_nCounter;    //  number of elements in the list
 
+    //  a block of nodes allocated in one piece by Compact(). nodes
+    //  that are not in one of the blocks are allocated on their own.
+    //
+    struct DL_NODEBLOCK
+    {
+        DL_NODEBLOCK*      pNext;       //  next block of this list
+        CdlNode<DATATYPE>* pNodes;      //  storage for nCapacity nodes
+        unsigned long      nCapacity;   //  number of nodes in the block
+        unsigned long      nUsed;       //  nodes handed out so far
+        unsigned long      nLive;       //  nodes still in use
+    };
+
+    DL_NODEBLOCK*      m_pBlocks;          //  all node blocks (0 if none)
+    DL_NODEBLOCK*      m_pCompactBlock;    //  target of a running compaction
+    CdlNode<DATATYPE>* m_pCompactCursor;   //  next node to be moved by CompactStep()
+
 
     //-------------------------------------------------------------------------
     //  methodes
@@ -182,6 +212,42 @@ private:
     inline DL_POSITION        PositionFromNode(const CdlNode<DATATYPE>* pNode)    const;
     inline CdlNode<DATATYPE>* NodeFromPosition(const DL_POSITION        position) const;
 
+    //  node memory management. FreeNode() releases nodes allocated
+    //  by new as well as nodes in the blocks of Compact()
+    //
+    void          FreeNode     (CdlNode<DATATYPE>* pNode);
+    bool          BeginCompact (void);
+    void          EndCompact   (void);
+    void          ReleaseBlock (DL_NODEBLOCK* pBlock);
+    bool          IsBlockNode  (const CdlNode<DATATYPE>* pNode) const;
+    void          FreeChain    (CdlNode<DATATYPE>* pChain);
+    inline void   CutOut       (CdlNode<DATATYPE>* pNode);
+    inline void   Append       (CdlNode<DATATYPE>* pNode);
+
+
+    //  collects the nodes cut out by RemoveIf(), Partition() and Unique().
+    //  the destructor updates the counters and releases the nodes, so the
+    //  list stays consistent when a predicate throws an exception.
+    //
+    class CdlRemoval
+    {
+    public:
+        CdlRemoval(CdlList& list, CdlList* pOther = 0);
+        ~CdlRemoval(void);
+
+        inline void          Cut     (CdlNode<DATATYPE>* pNode);
+        inline void          Release (CdlNode<DATATYPE>* pNode);
+        inline unsigned long GetCount(void) const { return m_nCount; }
+
+    private:
+        CdlList&           m_list;
+        CdlList*           m_pOther;   //  list receiving the cut out elements
+        CdlNode<DATATYPE>* m_pChain;   //  nodes to be released, linked by m_pPrev
+        unsigned long      m_nCount;   //  number of cut out elements
+    };
+
+    friend class CdlRemoval;
+
     
 public:
 
@@ -220,6 +286,12 @@ public:
     bool GetFirst (DATATYPE& rValue);
     bool GetLast  (DATATYPE& rValue);
     bool GetAt    (DATATYPE& rValue, const DL_POSITION position);
+
+    //  returns a reference to the data of an element in place. the
+    //  position is not verified, it must point to a node of a list
+    //  of this type, so it needs no list object.
+    //
+    static inline DATATYPE& ElementAt (const DL_POSITION position);
     
     
     //  methodes to delete elements from the list
@@ -232,15 +304,64 @@ public:
     bool DeleteAt    (const DL_POSITION position);
 
 
+    //  methodes to delete or move all elements matching a condition in one
+    //  pass through the list. the nodes are released together at the end.
+    //  'pred' is called as pred(const DATATYPE&) and 'eq' as
+    //  eq(const DATATYPE&, const DATATYPE&), both returning bool.
+    //
+    //  RemoveIf()  deletes every element for which pred() returns true.
+    //  Partition() moves every element for which pred() returns true to
+    //              the end of 'rOther', keeping their order.
+    //  Unique()    deletes every element that is equal to the element
+    //              preceding it, leaving the first of each group.
+    //
+    //  they return the number of deleted or moved elements.
+    //
+    template <class PREDICATE> unsigned long RemoveIf  (PREDICATE pred);
+    template <class PREDICATE> unsigned long Partition (PREDICATE pred, CdlList& rOther);
+    template <class EQUAL>     unsigned long Unique    (EQUAL eq);
+
+
+    //  methodes to move elements from another list to the end of this one
+    //  without copying them. Splice() moves all elements of 'rOther'.
+    //  MoveLast() moves the element at 'position' of 'rFrom' and returns
+    //  its position in this list, or DL_NULL when 'position' is invalid.
+    //  the position only changes, when the element was in a node block
+    //  of rFrom.Compact(), which has to be copied then.
+    //
+    void        Splice   (CdlList& rOther);
+    DL_POSITION MoveLast (CdlList& rFrom, const DL_POSITION position);
+
+
     //  queries to retrieve information about the list
     //
     inline unsigned long GetCount(void) const;
     inline bool          IsEmpty (void) const;
 
 
-    //  verification
+    //  verification. IsConsistent() runs through the whole list and checks
+    //  all links against each other and against the counter, it is meant
+    //  for tests and for debugging.
     //
     bool IsValidPosition(const DL_POSITION position);
+    bool IsConsistent   (void) const;
+
+
+    //  methodes to restore the locality of the nodes after many insertions
+    //  and deletions. the nodes are moved into one new contiguous block in
+    //  the order of the list and the memory of the old nodes is released.
+    //  every moved element gets a new position, so all positions retrieved
+    //  before become invalid. 'pfnRemap' is called with the old and the new
+    //  position of every moved element, if given.
+    //
+    //  Compact() moves the whole list at once and returns false, when the
+    //  block could not be allocated. CompactStep() moves at most 'nMaxNodes'
+    //  nodes per call and returns true as long as the pass is not finished.
+    //  the list can be modified between the steps, elements added after the
+    //  pass has started might be left out of the block.
+    //
+    bool Compact     (DL_REMAP pfnRemap = 0, void* pContext = 0);
+    bool CompactStep (unsigned long nMaxNodes, DL_REMAP pfnRemap = 0, void* pContext = 0);
 };
 
 
@@ -254,6 +375,9 @@ template <class DATATYPE> CdlList<DATATYPE>::CdlList(void)
     : m_pFirst   (DL_NULL)
     , m_pLast    (DL_NULL)
     , m_nCounter (0L)
+    , m_pBlocks        (0)
+    , m_pCompactBlock  (0)
+    , m_pCompactCursor (DL_NULL)
 {
     ;   //  intentionally left blank
 }
@@ -470,25 +594,27 @@ DL_POSITION CdlList<DATATYPE>::GetLastPosition(void)
 }
 
 
-//  returns a position value next to a given one
+//  returns a position value next to a given one. the next node in the
+//  list is linked by m_pPrev, as m_pPrev is DL_NULL for the last node
 //
 template <class DATATYPE>
 DL_POSITION CdlList<DATATYPE>::GetNextPosition(const DL_POSITION position)
 {
     return (false == IsValidPosition(position))
         ? PositionFromNode(DL_NULL)
-        : PositionFromNode((NodeFromPosition(position)->m_pNext));
+        : PositionFromNode((NodeFromPosition(position)->m_pPrev));
 }
 
 
-//  returns a position value previous to a given one
+//  returns a position value previous to a given one, which is
+//  linked by m_pNext, as m_pNext is DL_NULL for the first node
 //
 template <class DATATYPE>
 DL_POSITION CdlList<DATATYPE>::GetPreviousPosition(const DL_POSITION position)
 {
     return (false == IsValidPosition(position))
         ? PositionFromNode(DL_NULL)
-        : PositionFromNode((NodeFromPosition(position)->m_pPrev));
+        : PositionFromNode((NodeFromPosition(position)->m_pNext));
 }
 
 
@@ -499,7 +625,7 @@ bool CdlList<DATATYPE>::SetFirst(const DATATYPE& data)
 {
     return (false == IsEmpty())
         ? memmove(&m_pFirst->m_data, &data, sizeof(DATATYPE)), true
-        ; false;
+        : false;
 }
 
 
@@ -519,7 +645,7 @@ bool CdlList<DATATYPE>::SetLast(const DATATYPE& data)
 template <class DATATYPE>
 bool CdlList<DATATYPE>::SetAt(const DATATYPE& data, const DL_POSITION position)
 {
-    return (false == IsValidPosition(position))
+    return (true == IsValidPosition(position))
         ? memmove(&NodeFromPosition(position)->m_data, &data, sizeof(DATATYPE)), true
         : false;
 }
@@ -561,6 +687,15 @@ bool CdlList<DATATYPE>::GetAt(DATATYPE& rValue, const DL_POSITION position)
 }
 
 
+//  returns the data of an element given by its position by reference
+//
+template <class DATATYPE>
+DATATYPE& CdlList<DATATYPE>::ElementAt(const DL_POSITION position)
+{
+    return ((CdlNode<DATATYPE>*)(position))->m_data;
+}
+
+
 //  deletes the first node of the list
 //  returns false when list is empty
 //
@@ -595,7 +730,7 @@ bool CdlList<DATATYPE>::DeleteFirst(void)
     //  the node to delete has been cut out from the list,
     //  so it's safe now to delete it and decrease the counter
     //
-    delete pDelete; //  at this stage it must not be empty
+    FreeNode(pDelete); //  at this stage it must not be empty
     m_nCounter--;
 
     return true;
@@ -635,7 +770,7 @@ bool CdlList<DATATYPE>::DeleteLast(void)
     //  the node to delete has been cut out from the list,
     //  so it's safe now to delete it and decrease the counter
     //
-    delete pDelete;
+    FreeNode(pDelete);
     m_nCounter--;
 
     return true;
@@ -691,13 +826,334 @@ bool CdlList<DATATYPE>::DeleteAt(const DL_POSITION position)
 
     //  it's safe now to delete it and update the list count.
     //
-    delete pDelete;
+    FreeNode(pDelete);
     m_nCounter--;
 
     return true;
 }
 
 
+//  deletes all elements matching a predicate
+//
+template <class DATATYPE>
+template <class PREDICATE>
+unsigned long CdlList<DATATYPE>::RemoveIf(PREDICATE pred)
+{
+    CdlRemoval         removal(*this);
+    CdlNode<DATATYPE> *pIterator = m_pFirst;
+
+    while (DL_NULL != pIterator)
+    {
+        //  the node following in the list, CutOut() keeps this link
+        //
+        CdlNode<DATATYPE> *pNode = pIterator;
+        pIterator = pIterator->m_pPrev;
+
+        if (pred(pNode->m_data))
+        {
+            removal.Cut(pNode);
+            removal.Release(pNode);
+        }
+    }
+
+    return removal.GetCount();
+}
+
+
+//  moves all elements matching a predicate to the end of another list
+//
+template <class DATATYPE>
+template <class PREDICATE>
+unsigned long CdlList<DATATYPE>::Partition(PREDICATE pred, CdlList<DATATYPE>& rOther)
+{
+    if (this == &rOther)
+    {
+        return 0L;
+    }
+
+    CdlRemoval         removal(*this, &rOther);
+    CdlNode<DATATYPE> *pIterator = m_pFirst;
+
+    while (DL_NULL != pIterator)
+    {
+        CdlNode<DATATYPE> *pNode = pIterator;
+        pIterator = pIterator->m_pPrev;
+
+        if (false == pred(pNode->m_data))
+        {
+            continue;
+        }
+
+        //  nodes in a block of Compact() belong to this list, so
+        //  the other list gets a copy of them and they are released
+        //
+        CdlNode<DATATYPE> *pMove = pNode;
+
+        if (true == IsBlockNode(pNode))
+        {
+            pMove = new CdlNode<DATATYPE>(pNode->m_data);
+
+            if (DL_NULL == pMove)
+            {
+                continue;
+            }
+        }
+
+        removal.Cut(pNode);
+
+        if (pMove != pNode)
+        {
+            removal.Release(pNode);
+        }
+
+        rOther.Append(pMove);
+    }
+
+    return removal.GetCount();
+}
+
+
+//  deletes all elements equal to their preceding element
+//
+template <class DATATYPE>
+template <class EQUAL>
+unsigned long CdlList<DATATYPE>::Unique(EQUAL eq)
+{
+    if (true == IsEmpty())
+    {
+        return 0L;
+    }
+
+    CdlRemoval         removal(*this);
+    CdlNode<DATATYPE> *pKept     = m_pFirst;    //  the first of the current group
+    CdlNode<DATATYPE> *pIterator = m_pFirst->m_pPrev;
+
+    while (DL_NULL != pIterator)
+    {
+        CdlNode<DATATYPE> *pNode = pIterator;
+        pIterator = pIterator->m_pPrev;
+
+        if (eq(pKept->m_data, pNode->m_data))
+        {
+            removal.Cut(pNode);
+            removal.Release(pNode);
+        }
+
+        else
+        {
+            pKept = pNode;
+        }
+    }
+
+    return removal.GetCount();
+}
+
+
+//  moves all elements of another list to the end of this one
+//
+template <class DATATYPE>
+void CdlList<DATATYPE>::Splice(CdlList<DATATYPE>& rOther)
+{
+    if ( (this == &rOther) || (true == rOther.IsEmpty()) )
+    {
+        return;
+    }
+
+    //  the node blocks of the other list move along with their nodes
+    //
+    rOther.EndCompact();
+
+    if (0 != rOther.m_pBlocks)
+    {
+        DL_NODEBLOCK** ppLink = &m_pBlocks;
+
+        while (0 != *ppLink)
+        {
+            ppLink = &(*ppLink)->pNext;
+        }
+
+        *ppLink = rOther.m_pBlocks;
+    }
+
+    //  link the first node of the other list to the last one of this list
+    //
+    rOther.m_pFirst->m_pNext = m_pLast;
+
+    (DL_NULL != m_pLast)
+        ? m_pLast->m_pPrev = rOther.m_pFirst
+        : m_pFirst         = rOther.m_pFirst;
+
+    m_pLast     = rOther.m_pLast;
+    m_nCounter += rOther.m_nCounter;
+
+    //  the other list is empty now
+    //
+    rOther.m_pFirst   = DL_NULL;
+    rOther.m_pLast    = DL_NULL;
+    rOther.m_nCounter = 0L;
+    rOther.m_pBlocks  = 0;
+}
+
+
+//  moves one element of another list to the end of this one
+//
+template <class DATATYPE>
+DL_POSITION CdlList<DATATYPE>::MoveLast(CdlList<DATATYPE>& rFrom, const DL_POSITION position)
+{
+    if (false == rFrom.IsValidPosition(position))
+    {
+        return PositionFromNode(DL_NULL);
+    }
+
+    CdlNode<DATATYPE> *pNode = NodeFromPosition(position);
+    CdlNode<DATATYPE> *pMove = pNode;
+
+    //  a node in a block of the other list has to be copied
+    //
+    if ( (this != &rFrom) && (true == rFrom.IsBlockNode(pNode)) )
+    {
+        pMove = new CdlNode<DATATYPE>(pNode->m_data);
+
+        if (DL_NULL == pMove)
+        {
+            return PositionFromNode(DL_NULL);
+        }
+    }
+
+    rFrom.CutOut(pNode);
+    rFrom.m_nCounter--;
+
+    if (pMove != pNode)
+    {
+        rFrom.FreeNode(pNode);
+    }
+
+    Append(pMove);
+    m_nCounter++;
+
+    return PositionFromNode(pMove);
+}
+
+
+//  links a node as the new last one, the counter is not updated
+//
+template <class DATATYPE>
+void CdlList<DATATYPE>::Append(CdlNode<DATATYPE>* pNode)
+{
+    pNode->m_pPrev = DL_NULL;
+    pNode->m_pNext = m_pLast;
+
+    (DL_NULL != m_pLast)
+        ? m_pLast->m_pPrev = pNode
+        : m_pFirst         = pNode;
+
+    m_pLast = pNode;
+}
+
+
+//  cuts a node out of the list without releasing it. the counter is not
+//  updated and the node keeps its links, so a loop running through the
+//  list can continue with pNode->m_pPrev.
+//
+template <class DATATYPE>
+void CdlList<DATATYPE>::CutOut(CdlNode<DATATYPE>* pNode)
+{
+    (DL_NULL != pNode->m_pNext)
+        ? pNode->m_pNext->m_pPrev = pNode->m_pPrev
+        : m_pFirst                = pNode->m_pPrev;
+
+    (DL_NULL != pNode->m_pPrev)
+        ? pNode->m_pPrev->m_pNext = pNode->m_pNext
+        : m_pLast                 = pNode->m_pNext;
+
+    //  a running compaction continues with the following node
+    //
+    if (pNode == m_pCompactCursor)
+    {
+        m_pCompactCursor = pNode->m_pPrev;
+    }
+}
+
+
+//  the removal starts without any cut out nodes
+//
+template <class DATATYPE>
+CdlList<DATATYPE>::CdlRemoval::CdlRemoval(CdlList<DATATYPE>& list, CdlList<DATATYPE>* pOther)
+    : m_list   (list)
+    , m_pOther (pOther)
+    , m_pChain (DL_NULL)
+    , m_nCount (0L)
+{
+    ;   //  intentionally left blank
+}
+
+
+//  applies the number of cut out elements to the counters
+//  in one step and releases the collected nodes
+//
+template <class DATATYPE>
+CdlList<DATATYPE>::CdlRemoval::~CdlRemoval(void)
+{
+    m_list.m_nCounter -= m_nCount;
+
+    if (0 != m_pOther)
+    {
+        m_pOther->m_nCounter += m_nCount;
+    }
+
+    m_list.FreeChain(m_pChain);
+}
+
+
+//  cuts a node out of the list and counts it
+//
+template <class DATATYPE>
+void CdlList<DATATYPE>::CdlRemoval::Cut(CdlNode<DATATYPE>* pNode)
+{
+    m_list.CutOut(pNode);
+    m_nCount++;
+}
+
+
+//  adds a cut out node to the nodes to be released
+//
+template <class DATATYPE>
+void CdlList<DATATYPE>::CdlRemoval::Release(CdlNode<DATATYPE>* pNode)
+{
+    pNode->m_pPrev = m_pChain;
+    m_pChain       = pNode;
+}
+
+
+//  releases a chain of nodes cut out from the list, linked by m_pPrev
+//
+template <class DATATYPE>
+void CdlList<DATATYPE>::FreeChain(CdlNode<DATATYPE>* pChain)
+{
+    //  without blocks all nodes have been allocated by new,
+    //  so there is no need to look for their block
+    //
+    if (0 == m_pBlocks)
+    {
+        while (DL_NULL != pChain)
+        {
+            CdlNode<DATATYPE> *pDelete = pChain;
+            pChain = pChain->m_pPrev;
+            delete pDelete;
+        }
+
+        return;
+    }
+
+    while (DL_NULL != pChain)
+    {
+        CdlNode<DATATYPE> *pDelete = pChain;
+        pChain = pChain->m_pPrev;
+        FreeNode(pDelete);
+    }
+}
+
+
 //  this needs to be a little bit faster than the rest
 //  because it'll be called at least one time (by the destructor)
 //  for every object. so the iterator methodes aren't used here
@@ -712,10 +1168,10 @@ void CdlList<DATATYPE>::DeleteAll(void)
         while (pDelete->m_pPrev)
         {
             pDelete = pDelete->m_pPrev;
-            delete pDelete->m_pNext;
+            FreeNode(pDelete->m_pNext);
         }
 
-        delete pDelete;
+        FreeNode(pDelete);
 
         //  reset the list
         //
@@ -723,6 +1179,10 @@ void CdlList<DATATYPE>::DeleteAll(void)
         m_pLast    = DL_NULL;
         m_nCounter = 0L;
     }
+
+    //  a running compaction has nothing left to do
+    //
+    EndCompact();
 }
 
 
@@ -798,6 +1258,252 @@ bool CdlList<DATATYPE>::IsValidPosition(const DL_POSITION position)
 }
 
 
+//  moves the whole list into one new block of nodes
+//
+template <class DATATYPE>
+bool CdlList<DATATYPE>::Compact(DL_REMAP pfnRemap, void* pContext)
+{
+    //  a running incremental pass is abandoned, the
+    //  nodes it has moved already are simply moved again
+    //
+    EndCompact();
+
+    if (true == IsEmpty())
+    {
+        return true;
+    }
+
+    if (false == BeginCompact())
+    {
+        return false;
+    }
+
+    CompactStep(GetCount(), pfnRemap, pContext);
+
+    return true;
+}
+
+
+//  moves up to 'nMaxNodes' nodes into the block of the running pass. a new
+//  pass is started if none is running. returns false when the pass is done.
+//
+template <class DATATYPE>
+bool CdlList<DATATYPE>::CompactStep(unsigned long nMaxNodes, DL_REMAP pfnRemap, void* pContext)
+{
+    if ( (0 == m_pCompactBlock) && ((true == IsEmpty()) || (false == BeginCompact())) )
+    {
+        return false;
+    }
+
+    DL_NODEBLOCK* pBlock = m_pCompactBlock;
+
+    while ( (0L != nMaxNodes) && (DL_NULL != m_pCompactCursor) && (pBlock->nUsed < pBlock->nCapacity) )
+    {
+        CdlNode<DATATYPE>* pOld = m_pCompactCursor;
+
+        //  create the copy in the next free node of the block
+        //
+        CdlNode<DATATYPE>* pNew = new (&pBlock->pNodes[pBlock->nUsed]) CdlNode<DATATYPE>(pOld->m_data);
+
+        pBlock->nUsed++;
+        pBlock->nLive++;
+
+        //  put the copy in place of the original node
+        //
+        pNew->m_pPrev = pOld->m_pPrev;
+        pNew->m_pNext = pOld->m_pNext;
+
+        (DL_NULL != pNew->m_pPrev)
+            ? pNew->m_pPrev->m_pNext = pNew
+            : m_pLast                = pNew;
+
+        (DL_NULL != pNew->m_pNext)
+            ? pNew->m_pNext->m_pPrev = pNew
+            : m_pFirst               = pNew;
+
+        //  the node following in the list will be the next one to move
+        //
+        m_pCompactCursor = pNew->m_pPrev;
+
+        if (0 != pfnRemap)
+        {
+            pfnRemap(PositionFromNode(pOld), PositionFromNode(pNew), pContext);
+        }
+
+        FreeNode(pOld);
+        nMaxNodes--;
+    }
+
+    //  the pass is done, when the end of the list is reached or
+    //  the block is full because elements were added in between
+    //
+    if ( (DL_NULL == m_pCompactCursor) || (pBlock->nUsed == pBlock->nCapacity) )
+    {
+        EndCompact();
+        return false;
+    }
+
+    return true;
+}
+
+
+//  starts a compaction pass with a block big enough for the whole list
+//
+template <class DATATYPE>
+bool CdlList<DATATYPE>::BeginCompact(void)
+{
+    DL_NODEBLOCK* pBlock = new (std::nothrow) DL_NODEBLOCK;
+
+    if (0 == pBlock)
+    {
+        return false;
+    }
+
+    //  the storage is not initialized, the nodes are
+    //  constructed in it while they are moved
+    //
+    pBlock->pNodes = static_cast<CdlNode<DATATYPE>*>(
+        ::operator new(GetCount() * sizeof(CdlNode<DATATYPE>), std::nothrow));
+
+    if (DL_NULL == pBlock->pNodes)
+    {
+        delete pBlock;
+        return false;
+    }
+
+    pBlock->nCapacity = GetCount();
+    pBlock->nUsed     = 0L;
+    pBlock->nLive     = 0L;
+    pBlock->pNext     = m_pBlocks;
+    m_pBlocks         = pBlock;
+
+    m_pCompactBlock   = pBlock;
+    m_pCompactCursor  = m_pFirst;
+
+    return true;
+}
+
+
+//  finishes a running compaction pass. the block is released
+//  if all of the nodes moved into it have been deleted again.
+//
+template <class DATATYPE>
+void CdlList<DATATYPE>::EndCompact(void)
+{
+    DL_NODEBLOCK* pBlock = m_pCompactBlock;
+
+    m_pCompactBlock  = 0;
+    m_pCompactCursor = DL_NULL;
+
+    if ( (0 != pBlock) && (0L == pBlock->nLive) )
+    {
+        ReleaseBlock(pBlock);
+    }
+}
+
+
+//  removes a block from the list of blocks and releases its memory
+//
+template <class DATATYPE>
+void CdlList<DATATYPE>::ReleaseBlock(DL_NODEBLOCK* pBlock)
+{
+    DL_NODEBLOCK** ppLink = &m_pBlocks;
+
+    while (*ppLink != pBlock)
+    {
+        ppLink = &(*ppLink)->pNext;
+    }
+
+    *ppLink = pBlock->pNext;
+
+    ::operator delete(pBlock->pNodes);
+    delete pBlock;
+}
+
+
+//  returns true when a node is in one of the blocks of Compact()
+//
+template <class DATATYPE>
+bool CdlList<DATATYPE>::IsBlockNode(const CdlNode<DATATYPE>* pNode) const
+{
+    for (DL_NODEBLOCK* pBlock = m_pBlocks; 0 != pBlock; pBlock = pBlock->pNext)
+    {
+        if ( (pNode >= pBlock->pNodes) && (pNode < pBlock->pNodes + pBlock->nUsed) )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+//  releases a node that has been cut out from the list. nodes in a block
+//  are only destroyed, the block is released with its last node. there
+//  are only a few blocks at any time, so searching them is cheap.
+//
+template <class DATATYPE>
+void CdlList<DATATYPE>::FreeNode(CdlNode<DATATYPE>* pNode)
+{
+    //  a node cut out from the list still links to the node that
+    //  followed it, that one will be the next to move instead
+    //
+    if (pNode == m_pCompactCursor)
+    {
+        m_pCompactCursor = pNode->m_pPrev;
+    }
+
+    for (DL_NODEBLOCK* pBlock = m_pBlocks; 0 != pBlock; pBlock = pBlock->pNext)
+    {
+        if ( (pNode >= pBlock->pNodes) && (pNode < pBlock->pNodes + pBlock->nUsed) )
+        {
+            pNode->~CdlNode<DATATYPE>();
+
+            if ( (0L == --pBlock->nLive) && (pBlock != m_pCompactBlock) )
+            {
+                ReleaseBlock(pBlock);
+            }
+
+            return;
+        }
+    }
+
+    delete pNode;
+}
+
+
+//  verifies, that running through the list from the first node
+//  reaches the last node, with every node linked back to the one
+//  in front of it, and that the number of nodes is right
+//
+template <class DATATYPE>
+bool CdlList<DATATYPE>::IsConsistent(void) const
+{
+    if ( (DL_NULL == m_pFirst) != (DL_NULL == m_pLast) )
+    {
+        return false;
+    }
+
+    const CdlNode<DATATYPE> *pPrevious = DL_NULL;
+    unsigned long            nCount    = 0L;
+
+    for (const CdlNode<DATATYPE> *pIterator = m_pFirst; DL_NULL != pIterator; pIterator = pIterator->m_pPrev)
+    {
+        //  a wrong back link or too many nodes (like in a
+        //  cycle) make the list inconsistent
+        //
+        if ( (pIterator->m_pNext != pPrevious) || (++nCount > m_nCounter) )
+        {
+            return false;
+        }
+
+        pPrevious = pIterator;
+    }
+
+    return static_cast<bool>( (pPrevious == m_pLast) && (nCount == m_nCounter) );
+}
+
+
 //  casts an elements pointer to a DL_POSITION pointer
 //
 template <class DATATYPE>
@@ -817,4 +1523,4 @@ CdlNode<DATATYPE>* CdlList<DATATYPE>::NodeFromPosition(const DL_POSITION positio
 
 #endif  //  __CDOUBLELINKEDLIST_INCLUDED__
 
-//  end of file
\ No newline at end of file
+//  end of file
\ No newline at end of file
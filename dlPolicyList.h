@@ -0,0 +1,806 @@
+//=============================================================================
+//
+//  Copyright (c) 2004. Riccardo Riedl (www.riccardo-riedl.de)
+//
+//  Permission to use, copy, modify, distribute and sell this software and its
+//  documentation for any purpose is hereby granted without fee, provided that
+//  the above copyright notice appears in all copies and that both that
+//  copyright notice and this permission notice appear in supporting
+//  documentation.
+//
+//  There are no representations made about the suitability of this software
+//  for any purpose. It is provided "as is" without expressed or implied
+//  warranty.
+//
+//=============================================================================
+
+
+//=============================================================================
+//  preprocessor directives
+//=============================================================================
+
+//  include this file only once
+//
+#ifndef DL_CPOLICYLIST_INCLUDED__
+#define DL_CPOLICYLIST_INCLUDED__
+
+//  DL_POSITION type definition
+//
+#include "dlList.h"
+
+//  header file for std::nothrow
+//
+#include <new>
+
+//  symbol for null-pointer
+//
+#define DL_LINK_NULL ( static_cast< CdlLink* >( 0 ) )
+
+
+//=============================================================================
+//  CdlLink structure
+//
+//  description:    the links of a node of CdlPolicyList. unlike in CdlNode,
+//                  m_pNext points towards the end of the list. the list is
+//                  circular and closed by a sentinel link in the list
+//                  object, so no link is ever DL_LINK_NULL while a node is
+//                  in a list.
+//=============================================================================
+
+struct CdlLink
+{
+    CdlLink* m_pPrev;   //  the sentinel for the first node of the list
+    CdlLink* m_pNext;   //  the sentinel for the last node of the list
+};
+
+
+//=============================================================================
+//  checking policies
+//
+//  description:    decide at compile time if the positions passed to a
+//                  CdlPolicyList are verified. DL_CHECKED verifies them
+//                  like CdlList does and returns DL_NULL or false for
+//                  invalid ones, also allocation failures are reported.
+//                  with DL_UNCHECKED the caller guarantees, that every
+//                  position is valid and that the list is not empty when
+//                  reading or deleting the first or last element, and
+//                  failed allocations throw std::bad_alloc.
+//=============================================================================
+
+struct DL_CHECKED
+{
+    static const bool bEnabled = true;
+
+    static inline bool IsValid(const CdlLink* pSentinel, const CdlLink* pLink);
+};
+
+struct DL_UNCHECKED
+{
+    static const bool bEnabled = false;
+
+    static inline bool IsValid(const CdlLink* pSentinel, const CdlLink* pLink);
+};
+
+
+//  a position is valid, when it is neither zero nor the sentinel. in debug
+//  mode the whole list is searched for it, as CdlList::IsValidPosition() does
+//
+bool DL_CHECKED::IsValid(const CdlLink* pSentinel, const CdlLink* pLink)
+{
+    if ( (DL_LINK_NULL == pLink) || (pSentinel == pLink) )
+    {
+        return false;
+    }
+
+    #ifndef _DEBUG
+
+        return true;
+
+    #else
+
+        for (const CdlLink* pIterator = pSentinel->m_pNext; pIterator != pSentinel; pIterator = pIterator->m_pNext)
+        {
+            if (pIterator == pLink)
+            {
+                return true;
+            }
+        }
+
+        return false;
+
+    #endif  //  _DEBUG
+}
+
+//  without checking every position is valid
+//
+bool DL_UNCHECKED::IsValid(const CdlLink*, const CdlLink*)
+{
+    return true;
+}
+
+
+//=============================================================================
+//  counting policies
+//
+//  description:    decide at compile time if a CdlPolicyList keeps track
+//                  of the number of its elements. with DL_UNCOUNTED there
+//                  is no counter to update, but GetCount() has to run
+//                  through the whole list.
+//=============================================================================
+
+class DL_COUNTED
+{
+public:
+
+    static const bool bEnabled = true;
+
+protected:
+
+    DL_COUNTED(void);
+
+    inline void          AddCount  (unsigned long nCount);
+    inline void          SubCount  (unsigned long nCount);
+    inline void          ResetCount(void);
+    inline unsigned long Count     (void) const;
+
+private:
+
+    unsigned long m_nCounter;   //  number of elements in the list
+};
+
+class DL_UNCOUNTED
+{
+public:
+
+    static const bool bEnabled = false;
+
+protected:
+
+    inline void          AddCount  (unsigned long);
+    inline void          SubCount  (unsigned long);
+    inline void          ResetCount(void);
+    inline unsigned long Count     (void) const;
+};
+
+
+inline DL_COUNTED::DL_COUNTED(void)
+    : m_nCounter (0L)
+{
+    ;   //  intentionally left blank
+}
+
+void DL_COUNTED::AddCount(unsigned long nCount)
+{
+    m_nCounter += nCount;
+}
+
+void DL_COUNTED::SubCount(unsigned long nCount)
+{
+    m_nCounter -= nCount;
+}
+
+void DL_COUNTED::ResetCount(void)
+{
+    m_nCounter = 0L;
+}
+
+unsigned long DL_COUNTED::Count(void) const
+{
+    return m_nCounter;
+}
+
+//  nothing to count, the compiler removes the calls
+//
+void DL_UNCOUNTED::AddCount(unsigned long)
+{
+    ;   //  intentionally left blank
+}
+
+void DL_UNCOUNTED::SubCount(unsigned long)
+{
+    ;   //  intentionally left blank
+}
+
+void DL_UNCOUNTED::ResetCount(void)
+{
+    ;   //  intentionally left blank
+}
+
+unsigned long DL_UNCOUNTED::Count(void) const
+{
+    return 0L;
+}
+
+
+//=============================================================================
+//  CdlPolicyNode template class
+//
+//  description:    The CdlPolicyNode template class is the container for
+//                  elements of a CdlPolicyList
+//=============================================================================
+
+//  forward decleration of the CdlPolicyList template class,
+//  so that it can be declared as friend in CdlPolicyNode
+//
+template <class DATATYPE, class CHECKING, class COUNTING> class CdlPolicyList;
+
+
+//=============================================================================
+//  class decleration
+//-----------------------------------------------------------------------------
+
+template <class DATATYPE> class CdlPolicyNode : public CdlLink
+{
+
+    template <class, class, class> friend class CdlPolicyList;
+
+
+    //-------------------------------------------------------------------------
+    //  data members
+    //-------------------------------------------------------------------------
+
+private:
+
+    //  the data object to be stored in this node
+    //
+    DATATYPE m_data;
+
+
+    //-------------------------------------------------------------------------
+    //  methodes
+    //-------------------------------------------------------------------------
+
+private:
+
+    //  the constructor copies the passed element. the links are
+    //  set when the node is linked into the list.
+    //
+    CdlPolicyNode(const DATATYPE& data);
+
+};
+
+
+//=============================================================================
+//  definitions
+//-----------------------------------------------------------------------------
+
+template <class DATATYPE> CdlPolicyNode<DATATYPE>::CdlPolicyNode(const DATATYPE& data)
+    : m_data (data)
+{
+    ;   //  intentionally left blank
+}
+
+
+
+//=============================================================================
+//  CdlPolicyList template class
+//
+//  description:    doubly-linked list like CdlList, with the verification
+//                  of positions and the element counter chosen at compile
+//                  time. the list is circular with a sentinel, so linking
+//                  and unlinking a node never has to handle the first or
+//                  last node of the list separately. as all policy
+//                  decisions are constants, the compiler removes the
+//                  branches of the disabled features completely.
+//=============================================================================
+
+
+//=============================================================================
+//  class decleration
+//-----------------------------------------------------------------------------
+
+template <class DATATYPE, class CHECKING = DL_CHECKED, class COUNTING = DL_COUNTED>
+class CdlPolicyList : private COUNTING
+{
+
+    //-------------------------------------------------------------------------
+    //  types
+    //-------------------------------------------------------------------------
+
+private:
+
+    typedef CdlPolicyNode<DATATYPE> CdlNodeType;
+
+
+    //-------------------------------------------------------------------------
+    //  data members
+    //-------------------------------------------------------------------------
+
+private:
+
+    //  links to the last (m_pPrev) and the first (m_pNext) node,
+    //  both point to the sentinel itself when the list is empty
+    //
+    CdlLink m_sentinel;
+
+
+    //-------------------------------------------------------------------------
+    //  methodes
+    //-------------------------------------------------------------------------
+
+public:
+
+    CdlPolicyList(void);
+    ~CdlPolicyList(void);
+
+
+private:
+
+    //  not copyable, the sentinel is linked to the nodes
+    //
+    CdlPolicyList(const CdlPolicyList&);
+    CdlPolicyList& operator=(const CdlPolicyList&);
+
+    //  casting functions. the sentinel is returned as DL_NULL position
+    //
+    inline DL_POSITION  PositionFromLink(const CdlLink*    pLink)    const;
+    inline CdlLink*     LinkFromPosition(const DL_POSITION position) const;
+    static inline CdlNodeType* NodeFromLink(CdlLink* pLink);
+
+    //  creates a node and links it in front of 'pNext'
+    //
+    inline DL_POSITION Insert(const DATATYPE& data, CdlLink* pNext);
+
+    //  unlinks and deletes a node
+    //
+    inline void Remove(CdlLink* pLink);
+
+
+public:
+
+    //  methodes to add new elements to the list. the return-values are the
+    //  postition of the new element in the list. with DL_CHECKED they return
+    //  DL_NULL on failure (when the 'position' argument is invalid or the
+    //  node could not be allocated).
+    //
+    DL_POSITION AddFirst  (const DATATYPE& data);
+    DL_POSITION AddLast   (const DATATYPE& data);
+    DL_POSITION AddAfter  (const DATATYPE& data, const DL_POSITION position);
+    DL_POSITION AddBefore (const DATATYPE& data, const DL_POSITION position);
+
+
+    //  methodes to get the DL_POSITION value for an element
+    //  they return DL_NULL when the list is empty or the last and/or first
+    //  position in the list has already been reached. with DL_CHECKED they
+    //  also return DL_NULL when 'position' doesn't point to a valid node.
+    //
+    DL_POSITION GetFirstPosition    (void) const;
+    DL_POSITION GetLastPosition     (void) const;
+    DL_POSITION GetNextPosition     (const DL_POSITION position) const;
+    DL_POSITION GetPreviousPosition (const DL_POSITION position) const;
+
+
+    //  methodes to overwrite the data of an element in the list
+    //  with DL_CHECKED they return false when the list is empty
+    //  or the 'position' argument doesn't point to a valid node
+    //
+    bool SetFirst (const DATATYPE& data);
+    bool SetLast  (const DATATYPE& data);
+    bool SetAt    (const DATATYPE& data, const DL_POSITION position);
+
+
+    //  methodes to get the data of an element
+    //
+    bool GetFirst (DATATYPE& rValue) const;
+    bool GetLast  (DATATYPE& rValue) const;
+    bool GetAt    (DATATYPE& rValue, const DL_POSITION position) const;
+
+
+    //  methodes to delete elements from the list
+    //  with DL_CHECKED they return false when the list is empty
+    //  or the 'position' argument doesn't point to a valid node
+    //
+    bool DeleteFirst (void);
+    bool DeleteLast  (void);
+    void DeleteAll   (void);
+    bool DeleteAt    (const DL_POSITION position);
+
+
+    //  queries to retrieve information about the list. GetCount()
+    //  runs through the whole list with DL_UNCOUNTED
+    //
+    unsigned long GetCount(void) const;
+    inline bool   IsEmpty (void) const;
+
+
+    //  verification, always true with DL_UNCHECKED
+    //
+    bool IsValidPosition(const DL_POSITION position) const;
+};
+
+
+//=============================================================================
+//  definitions
+//-----------------------------------------------------------------------------
+
+//  the constructor initzializes the list as empty,
+//  the sentinel is linked to itself
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+CdlPolicyList<DATATYPE, CHECKING, COUNTING>::CdlPolicyList(void)
+{
+    m_sentinel.m_pPrev = &m_sentinel;
+    m_sentinel.m_pNext = &m_sentinel;
+}
+
+
+//  the destructor deletes all elements from the list
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+CdlPolicyList<DATATYPE, CHECKING, COUNTING>::~CdlPolicyList(void)
+{
+    DeleteAll();
+}
+
+
+//  creates a new node and links it in front of a given one. with the
+//  sentinel there is always a node in front and one behind the new one.
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+DL_POSITION CdlPolicyList<DATATYPE, CHECKING, COUNTING>::Insert(const DATATYPE& data, CdlLink* pNext)
+{
+    CdlNodeType *pNew = (CHECKING::bEnabled)
+        ? new (std::nothrow) CdlNodeType(data)
+        : new CdlNodeType(data);
+
+    if ( (CHECKING::bEnabled) && (0 == pNew) )
+    {
+        return PositionFromLink(DL_LINK_NULL);
+    }
+
+    pNew->m_pPrev           = pNext->m_pPrev;
+    pNew->m_pNext           = pNext;
+    pNext->m_pPrev->m_pNext = pNew;
+    pNext->m_pPrev          = pNew;
+
+    COUNTING::AddCount(1L);
+
+    //  the new node is never the sentinel
+    //
+    return (DL_POSITION)(static_cast<CdlLink*>(pNew));
+}
+
+
+//  unlinks a node and deletes it
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+void CdlPolicyList<DATATYPE, CHECKING, COUNTING>::Remove(CdlLink* pLink)
+{
+    pLink->m_pPrev->m_pNext = pLink->m_pNext;
+    pLink->m_pNext->m_pPrev = pLink->m_pPrev;
+
+    delete NodeFromLink(pLink);
+
+    COUNTING::SubCount(1L);
+}
+
+
+//  creates and adds a new element at the start of the list
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+DL_POSITION CdlPolicyList<DATATYPE, CHECKING, COUNTING>::AddFirst(const DATATYPE& data)
+{
+    return Insert(data, m_sentinel.m_pNext);
+}
+
+
+//  creates a new node and appends it to the end of the list
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+DL_POSITION CdlPolicyList<DATATYPE, CHECKING, COUNTING>::AddLast(const DATATYPE& data)
+{
+    return Insert(data, &m_sentinel);
+}
+
+
+//  creates and adds a new element after a given position
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+DL_POSITION CdlPolicyList<DATATYPE, CHECKING, COUNTING>::AddAfter(const DATATYPE& data, const DL_POSITION position)
+{
+    if ( (CHECKING::bEnabled) && (false == IsValidPosition(position)) )
+    {
+        return PositionFromLink(DL_LINK_NULL);
+    }
+
+    return Insert(data, LinkFromPosition(position)->m_pNext);
+}
+
+
+//  creates a new node and inserts it previous to a given position
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+DL_POSITION CdlPolicyList<DATATYPE, CHECKING, COUNTING>::AddBefore(const DATATYPE& data, const DL_POSITION position)
+{
+    if ( (CHECKING::bEnabled) && (false == IsValidPosition(position)) )
+    {
+        return PositionFromLink(DL_LINK_NULL);
+    }
+
+    return Insert(data, LinkFromPosition(position));
+}
+
+
+//  returns a position value for the first element
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+DL_POSITION CdlPolicyList<DATATYPE, CHECKING, COUNTING>::GetFirstPosition(void) const
+{
+    return PositionFromLink(m_sentinel.m_pNext);
+}
+
+
+//  returns a position value for the last element
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+DL_POSITION CdlPolicyList<DATATYPE, CHECKING, COUNTING>::GetLastPosition(void) const
+{
+    return PositionFromLink(m_sentinel.m_pPrev);
+}
+
+
+//  returns a position value next to a given one
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+DL_POSITION CdlPolicyList<DATATYPE, CHECKING, COUNTING>::GetNextPosition(const DL_POSITION position) const
+{
+    if ( (CHECKING::bEnabled) && (false == IsValidPosition(position)) )
+    {
+        return PositionFromLink(DL_LINK_NULL);
+    }
+
+    return PositionFromLink(LinkFromPosition(position)->m_pNext);
+}
+
+
+//  returns a position value previous to a given one
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+DL_POSITION CdlPolicyList<DATATYPE, CHECKING, COUNTING>::GetPreviousPosition(const DL_POSITION position) const
+{
+    if ( (CHECKING::bEnabled) && (false == IsValidPosition(position)) )
+    {
+        return PositionFromLink(DL_LINK_NULL);
+    }
+
+    return PositionFromLink(LinkFromPosition(position)->m_pPrev);
+}
+
+
+//  overwrites the data of the first element
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+bool CdlPolicyList<DATATYPE, CHECKING, COUNTING>::SetFirst(const DATATYPE& data)
+{
+    if ( (CHECKING::bEnabled) && (true == IsEmpty()) )
+    {
+        return false;
+    }
+
+    NodeFromLink(m_sentinel.m_pNext)->m_data = data;
+
+    return true;
+}
+
+
+//  overwrites the data of the last element
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+bool CdlPolicyList<DATATYPE, CHECKING, COUNTING>::SetLast(const DATATYPE& data)
+{
+    if ( (CHECKING::bEnabled) && (true == IsEmpty()) )
+    {
+        return false;
+    }
+
+    NodeFromLink(m_sentinel.m_pPrev)->m_data = data;
+
+    return true;
+}
+
+
+//  overwrites the data of an element given by its position
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+bool CdlPolicyList<DATATYPE, CHECKING, COUNTING>::SetAt(const DATATYPE& data, const DL_POSITION position)
+{
+    if ( (CHECKING::bEnabled) && (false == IsValidPosition(position)) )
+    {
+        return false;
+    }
+
+    NodeFromLink(LinkFromPosition(position))->m_data = data;
+
+    return true;
+}
+
+
+//  copies the data of the first element into a given reference
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+bool CdlPolicyList<DATATYPE, CHECKING, COUNTING>::GetFirst(DATATYPE& rValue) const
+{
+    if ( (CHECKING::bEnabled) && (true == IsEmpty()) )
+    {
+        return false;
+    }
+
+    rValue = NodeFromLink(m_sentinel.m_pNext)->m_data;
+
+    return true;
+}
+
+
+//  copies the data of the last element into a given reference
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+bool CdlPolicyList<DATATYPE, CHECKING, COUNTING>::GetLast(DATATYPE& rValue) const
+{
+    if ( (CHECKING::bEnabled) && (true == IsEmpty()) )
+    {
+        return false;
+    }
+
+    rValue = NodeFromLink(m_sentinel.m_pPrev)->m_data;
+
+    return true;
+}
+
+
+//  copies the data of an element give by its position into a reference
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+bool CdlPolicyList<DATATYPE, CHECKING, COUNTING>::GetAt(DATATYPE& rValue, const DL_POSITION position) const
+{
+    if ( (CHECKING::bEnabled) && (false == IsValidPosition(position)) )
+    {
+        return false;
+    }
+
+    rValue = NodeFromLink(LinkFromPosition(position))->m_data;
+
+    return true;
+}
+
+
+//  deletes the first node of the list
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+bool CdlPolicyList<DATATYPE, CHECKING, COUNTING>::DeleteFirst(void)
+{
+    if ( (CHECKING::bEnabled) && (true == IsEmpty()) )
+    {
+        return false;
+    }
+
+    Remove(m_sentinel.m_pNext);
+
+    return true;
+}
+
+
+//  deletes the last node of the list
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+bool CdlPolicyList<DATATYPE, CHECKING, COUNTING>::DeleteLast(void)
+{
+    if ( (CHECKING::bEnabled) && (true == IsEmpty()) )
+    {
+        return false;
+    }
+
+    Remove(m_sentinel.m_pPrev);
+
+    return true;
+}
+
+
+//  deletes a node given by position from the list
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+bool CdlPolicyList<DATATYPE, CHECKING, COUNTING>::DeleteAt(const DL_POSITION position)
+{
+    if ( (CHECKING::bEnabled) && (false == IsValidPosition(position)) )
+    {
+        return false;
+    }
+
+    Remove(LinkFromPosition(position));
+
+    return true;
+}
+
+
+//  deletes all nodes without unlinking them one by one
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+void CdlPolicyList<DATATYPE, CHECKING, COUNTING>::DeleteAll(void)
+{
+    CdlLink *pDelete = m_sentinel.m_pNext;
+
+    while (pDelete != &m_sentinel)
+    {
+        CdlLink *pNext = pDelete->m_pNext;
+        delete NodeFromLink(pDelete);
+        pDelete = pNext;
+    }
+
+    m_sentinel.m_pPrev = &m_sentinel;
+    m_sentinel.m_pNext = &m_sentinel;
+
+    COUNTING::ResetCount();
+}
+
+
+//  returns the number of elements in the list
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+unsigned long CdlPolicyList<DATATYPE, CHECKING, COUNTING>::GetCount(void) const
+{
+    if (COUNTING::bEnabled)
+    {
+        return COUNTING::Count();
+    }
+
+    unsigned long nCount = 0L;
+
+    for (const CdlLink* pIterator = m_sentinel.m_pNext; pIterator != &m_sentinel; pIterator = pIterator->m_pNext)
+    {
+        nCount++;
+    }
+
+    return nCount;
+}
+
+
+//  returns true when the list is empty, the
+//  sentinel is the only link then
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+bool CdlPolicyList<DATATYPE, CHECKING, COUNTING>::IsEmpty(void) const
+{
+    return static_cast<bool>( m_sentinel.m_pNext == &m_sentinel );
+}
+
+
+//  tests if a position is valid
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+bool CdlPolicyList<DATATYPE, CHECKING, COUNTING>::IsValidPosition(const DL_POSITION position) const
+{
+    return CHECKING::IsValid(&m_sentinel, LinkFromPosition(position));
+}
+
+
+//  casts a link pointer to a DL_POSITION pointer, the
+//  sentinel marks the end of the list and becomes DL_NULL
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+DL_POSITION CdlPolicyList<DATATYPE, CHECKING, COUNTING>::PositionFromLink(const CdlLink* pLink) const
+{
+    return (pLink != &m_sentinel)
+        ? (DL_POSITION)(pLink)
+        : (DL_POSITION)(0);
+}
+
+
+//  casts a DL_POSITION pointer to a link pointer
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+CdlLink* CdlPolicyList<DATATYPE, CHECKING, COUNTING>::LinkFromPosition(const DL_POSITION position) const
+{
+    return (CdlLink*)(position);
+}
+
+
+//  casts a link pointer to its node, it must not be the sentinel
+//
+template <class DATATYPE, class CHECKING, class COUNTING>
+CdlPolicyNode<DATATYPE>* CdlPolicyList<DATATYPE, CHECKING, COUNTING>::NodeFromLink(CdlLink* pLink)
+{
+    return static_cast<CdlNodeType*>(pLink);
+}
+
+#endif  //  DL_CPOLICYLIST_INCLUDED__
+
+//  end of file
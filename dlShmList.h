@@ -0,0 +1,1516 @@
+//=============================================================================
+//
+//  Copyright (c) 2004. Riccardo Riedl (www.riccardo-riedl.de)
+//
+//  Permission to use, copy, modify, distribute and sell this software and its
+//  documentation for any purpose is hereby granted without fee, provided that
+//  the above copyright notice appears in all copies and that both that
+//  copyright notice and this permission notice appear in supporting
+//  documentation.
+//
+//  There are no representations made about the suitability of this software
+//  for any purpose. It is provided "as is" without expressed or implied
+//  warranty.
+//
+//=============================================================================
+
+
+//=============================================================================
+//  preprocessor directives
+//=============================================================================
+
+//  include this file only once
+//
+#ifndef DL_CSHAREDMEMORYLIST_INCLUDED__
+#define DL_CSHAREDMEMORYLIST_INCLUDED__
+
+//  DL_POSITION type definition
+//
+#include "dlList.h"
+
+//  header files for memmove(), ptrdiff_t, typeid and the posix shared
+//  memory, memory mapping and process-shared mutex functions
+//
+#include <string.h>
+#include <stddef.h>
+#include <typeinfo>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//  symbol for null-pointer
+//
+#define DL_SHM_NULL ( static_cast< CdlShmNode<DATATYPE>* >( 0 ) )
+
+//  magic number written to a segment once it is completely initialized
+//
+#define DL_SHM_MAGIC ( 0x444C5348UL )
+
+//  value of CdlShmNode::m_nNext while a node is in the free list. links
+//  are distances between aligned addresses, so they are never odd.
+//
+#define DL_SHM_FREE ( 1 )
+
+
+//=============================================================================
+//  CdlShmNode template class
+//
+//  description:    The CdlShmNode template class is the container for
+//                  elements of a list in a shared memory segment. The links
+//                  are stored as offsets relative to the address of the link
+//                  itself, so they stay valid no matter at which address the
+//                  segment is mapped into a process. An offset of zero is
+//                  the null link.
+//=============================================================================
+
+//  forward decleration of the CdlShmList template class,
+//  so that it can be declared as friend in CdlShmNode
+//
+template <class DATATYPE> class CdlShmList;
+
+
+//=============================================================================
+//  class decleration
+//-----------------------------------------------------------------------------
+
+template <class DATATYPE> class CdlShmNode
+{
+
+    friend class CdlShmList<DATATYPE>;
+
+
+    //-------------------------------------------------------------------------
+    //  data members
+    //-------------------------------------------------------------------------
+
+private:
+
+    //  self-relative offsets to the previous and the next node.
+    //  they have the same meaning as CdlNode::m_pPrev and CdlNode::m_pNext.
+    //  while a node is unused, m_nPrev links it into the free list and
+    //  m_nNext is DL_SHM_FREE.
+    //
+    ptrdiff_t m_nPrev;  //  if 0 this is the last node in the list
+    ptrdiff_t m_nNext;  //  if 0 this is the first node in the list
+
+    //  the data object to be stored in this node
+    //
+    DATATYPE m_data;
+
+
+    //-------------------------------------------------------------------------
+    //  methodes
+    //-------------------------------------------------------------------------
+
+private:
+
+    //  nodes live in the shared memory segment,
+    //  they are never constructed or copied
+    //
+    CdlShmNode(void);
+    CdlShmNode(const CdlShmNode&);
+
+    //  link accessors converting between offsets and pointers
+    //
+    inline CdlShmNode* GetPrev(void) const;
+    inline CdlShmNode* GetNext(void) const;
+    inline void        SetPrev(const CdlShmNode* pNode);
+    inline void        SetNext(const CdlShmNode* pNode);
+
+    //  queries to test if an element is
+    //  the first or last one in a list
+    //
+    inline bool IsLast(void)  const;
+    inline bool IsFirst(void) const;
+
+    //  returns true while the node is in the free list
+    //
+    inline bool IsFree(void) const;
+
+    //  conversion of a self-relative offset stored at 'pLink' into a
+    //  pointer and back. they are also used for the segment header links.
+    //
+    static inline CdlShmNode* FromOffset(const ptrdiff_t* pLink);
+    static inline ptrdiff_t   ToOffset  (const ptrdiff_t* pLink, const CdlShmNode* pNode);
+
+};
+
+
+//=============================================================================
+//  definitions
+//-----------------------------------------------------------------------------
+
+//  converts the offset stored at 'pLink' into a pointer to the linked node
+//
+template <class DATATYPE>
+CdlShmNode<DATATYPE>* CdlShmNode<DATATYPE>::FromOffset(const ptrdiff_t* pLink)
+{
+    return (0 == *pLink)
+        ? DL_SHM_NULL
+        : (CdlShmNode<DATATYPE>*)((char*)(pLink) + *pLink);
+}
+
+//  computes the offset to be stored at 'pLink' to link to 'pNode'
+//
+template <class DATATYPE>
+ptrdiff_t CdlShmNode<DATATYPE>::ToOffset(const ptrdiff_t* pLink, const CdlShmNode<DATATYPE>* pNode)
+{
+    return (DL_SHM_NULL == pNode)
+        ? 0
+        : (const char*)(pNode) - (const char*)(pLink);
+}
+
+template <class DATATYPE>
+CdlShmNode<DATATYPE>* CdlShmNode<DATATYPE>::GetPrev(void) const
+{
+    return FromOffset(&m_nPrev);
+}
+
+template <class DATATYPE>
+CdlShmNode<DATATYPE>* CdlShmNode<DATATYPE>::GetNext(void) const
+{
+    return FromOffset(&m_nNext);
+}
+
+template <class DATATYPE>
+void CdlShmNode<DATATYPE>::SetPrev(const CdlShmNode<DATATYPE>* pNode)
+{
+    m_nPrev = ToOffset(&m_nPrev, pNode);
+}
+
+template <class DATATYPE>
+void CdlShmNode<DATATYPE>::SetNext(const CdlShmNode<DATATYPE>* pNode)
+{
+    m_nNext = ToOffset(&m_nNext, pNode);
+}
+
+//  they return true, if the node is either the
+//  last or the first element of a list.
+//
+template <class DATATYPE> bool CdlShmNode<DATATYPE>::IsLast(void) const
+{
+    return ( static_cast<bool>(0 == m_nPrev) );
+}
+
+template <class DATATYPE> bool CdlShmNode<DATATYPE>::IsFirst(void) const
+{
+    return ( static_cast<bool>(0 == m_nNext) );
+}
+
+template <class DATATYPE> bool CdlShmNode<DATATYPE>::IsFree(void) const
+{
+    return ( static_cast<bool>(DL_SHM_FREE == m_nNext) );
+}
+
+
+
+//=============================================================================
+//  CdlShmList template class
+//
+//  description:    doubly-linked list living in a named posix shared memory
+//                  segment, so that several processes can work on the same
+//                  list without copying the elements. The nodes are taken
+//                  from a fixed size pool inside the segment and the list
+//                  is protected by a process-shared mutex.
+//
+//                  DATATYPE must not contain pointers or other process
+//                  local resources, as it is copied bytewise into the
+//                  segment. DL_POSITION values are only valid in the
+//                  process that retrieved them.
+//=============================================================================
+
+
+//=============================================================================
+//  class decleration
+//-----------------------------------------------------------------------------
+
+template <class DATATYPE> class CdlShmList
+{
+
+    //-------------------------------------------------------------------------
+    //  segment layout
+    //-------------------------------------------------------------------------
+
+private:
+
+    //  the header at the start of the segment. the node pool follows
+    //  directly behind it. all links are self-relative offsets.
+    //
+    struct DL_SHM_HEADER
+    {
+        unsigned long   nMagic;     //  DL_SHM_MAGIC once initialized
+        unsigned long   nNodeSize;  //  sizeof(CdlShmNode<DATATYPE>)
+        unsigned long   nDataSize;  //  sizeof(DATATYPE)
+        unsigned long   nDataAlign; //  alignment of DATATYPE
+        unsigned long   nTypeId;    //  see TypeId()
+        unsigned long   nCapacity;  //  number of nodes in the pool
+        unsigned long   nUsed;      //  nodes taken from the pool so far
+        unsigned long   nAttached;  //  number of attached list objects
+        unsigned long   nCounter;   //  number of elements in the list
+        unsigned long   nDamaged;   //  set when a process died holding the lock
+
+        ptrdiff_t       nFirst;     //  link to the first node
+        ptrdiff_t       nLast;      //  link to the last node
+        ptrdiff_t       nFree;      //  link to the first unused node
+
+        pthread_mutex_t mutex;      //  process-shared, recursive and robust
+    };
+
+
+    //-------------------------------------------------------------------------
+    //  data members
+    //-------------------------------------------------------------------------
+
+private:
+
+    DL_SHM_HEADER*        m_pHeader; //  start of the mapping (0 if detached)
+    CdlShmNode<DATATYPE>* m_pPool;   //  first node of the pool
+    size_t                m_nSize;   //  size of the mapping in bytes
+
+
+    //-------------------------------------------------------------------------
+    //  methodes
+    //-------------------------------------------------------------------------
+
+public:
+
+    CdlShmList(void);
+    ~CdlShmList(void);
+
+
+private:
+
+    //  not copyable, every object holds its own mapping
+    //
+    CdlShmList(const CdlShmList&);
+    CdlShmList& operator=(const CdlShmList&);
+
+    //  casting functions
+    //
+    inline DL_POSITION           PositionFromNode(const CdlShmNode<DATATYPE>* pNode)    const;
+    inline CdlShmNode<DATATYPE>* NodeFromPosition(const DL_POSITION           position) const;
+
+    //  accessors for the list links in the segment header
+    //
+    inline CdlShmNode<DATATYPE>* First(void) const;
+    inline CdlShmNode<DATATYPE>* Last (void) const;
+    inline void                  SetFirstNode(const CdlShmNode<DATATYPE>* pNode);
+    inline void                  SetLastNode (const CdlShmNode<DATATYPE>* pNode);
+
+    //  node allocator working on the pool in the segment
+    //
+    CdlShmNode<DATATYPE>* AllocNode(const DATATYPE& data);
+    void                  FreeNode (CdlShmNode<DATATYPE>* pNode);
+
+    //  size of the segment header rounded up to the node alignment
+    //
+    static inline size_t HeaderSize(void);
+
+    //  the alignment of DATATYPE and the id stored in the header to
+    //  identify the type. without an id passed by the caller it is a
+    //  hash of the name of DATATYPE as given by typeid().
+    //
+    static inline size_t        DataAlign(void);
+    static        unsigned long TypeId   (unsigned long nTypeId);
+
+    //  maps an opened segment and sets up the members
+    //
+    bool Map(int nFile, size_t nSize);
+    void Unmap(void);
+
+    //  locks the mutex of the segment and takes it over, when its owner
+    //  died. unlike Lock() it also succeeds on a damaged list.
+    //
+    bool LockSegment(void) const;
+
+
+    //  scoped lock used by every operation
+    //
+    class CdlShmGuard
+    {
+    public:
+        CdlShmGuard(const CdlShmList& list) : m_list(list), m_bLocked(list.Lock()) { ; }
+        ~CdlShmGuard(void) { if (m_bLocked) m_list.Unlock(); }
+        bool IsLocked(void) const { return m_bLocked; }
+    private:
+        const CdlShmList& m_list;
+        const bool        m_bLocked;
+    };
+
+
+public:
+
+    //  methodes to create, attach and detach a segment. Create() fails when
+    //  a segment with the same name exists already. 'pszName' follows the
+    //  rules of shm_open(), so it should start with a slash. Attach() fails
+    //  when the size, the alignment or the id of DATATYPE differ from the
+    //  ones the segment was created with. 'nTypeId' can be used to tell
+    //  types apart, whose names typeid() reports differently in the
+    //  processes, e.g. when they are built by different compilers.
+    //
+    bool        Create  (const char* pszName, unsigned long nCapacity, unsigned long nTypeId = 0L);
+    bool        Attach  (const char* pszName, unsigned long nTypeId = 0L);
+    void        Detach  (void);
+    static bool Unlink  (const char* pszName);
+
+
+    //  the mutex of the segment. every methode locks it on its own, but
+    //  it is recursive, so Lock() and Unlock() can be used to make a
+    //  sequence of calls (like a traversal) atomic. Lock() returns false
+    //  when the list is not attached, the mutex can not be locked or the
+    //  list is damaged. all other methodes fail in that case as well.
+    //
+    bool Lock  (void) const;
+    void Unlock(void) const;
+
+
+    //  a process that died while holding the mutex might have left the
+    //  list in the middle of an operation. the list is marked as damaged
+    //  then and refuses any access, until Reset() empties it.
+    //
+    bool IsDamaged(void) const;
+    bool Reset    (void);
+
+
+    //  methodes to add new elements to the list. the return-values are the
+    //  postition of the new element in the list. they return DL_NULL when
+    //  the node pool is exhausted or the 'position' argument is invalid.
+    //
+    DL_POSITION AddFirst  (const DATATYPE& data);
+    DL_POSITION AddLast   (const DATATYPE& data);
+    DL_POSITION AddAfter  (const DATATYPE& data, const DL_POSITION position);
+    DL_POSITION AddBefore (const DATATYPE& data, const DL_POSITION position);
+
+
+    //  methodes to get the DL_POSITION value for an element
+    //  they return DL_NULL when the list is empty, the last and/or first position in
+    //  the list has already been reached or the 'position' argument doesn't
+    //  point to a valid node
+    //
+    DL_POSITION GetFirstPosition    (void);
+    DL_POSITION GetLastPosition     (void);
+    DL_POSITION GetNextPosition     (const DL_POSITION position);
+    DL_POSITION GetPreviousPosition (const DL_POSITION position);
+
+
+    //  methodes to overwrite the data of an element in the list
+    //  they return false when the list is empty or the 'position'
+    //  argument doesn't point to a valid node
+    //
+    bool SetFirst (const DATATYPE& data);
+    bool SetLast  (const DATATYPE& data);
+    bool SetAt    (const DATATYPE& data, const DL_POSITION position);
+
+
+    //  methodes to get the data of an element
+    //
+    bool GetFirst (DATATYPE& rValue);
+    bool GetLast  (DATATYPE& rValue);
+    bool GetAt    (DATATYPE& rValue, const DL_POSITION position);
+
+
+    //  methodes to delete elements from the list
+    //  they return false when the list is empty or the 'position' argument
+    //  doesn't point to a valid node
+    //
+    bool DeleteFirst (void);
+    bool DeleteLast  (void);
+    void DeleteAll   (void);
+    bool DeleteAt    (const DL_POSITION position);
+
+
+    //  queries to retrieve information about the list
+    //
+    unsigned long GetCount   (void) const;
+    unsigned long GetCapacity(void) const;
+    unsigned long GetAttached(void) const;
+    bool          IsEmpty    (void) const;
+    inline bool   IsAttached (void) const;
+
+
+    //  verification
+    //
+    bool IsValidPosition(const DL_POSITION position);
+};
+
+
+//=============================================================================
+//  definitions
+//-----------------------------------------------------------------------------
+
+//  the constructor initzializes the list as detached
+//
+template <class DATATYPE> CdlShmList<DATATYPE>::CdlShmList(void)
+    : m_pHeader (0)
+    , m_pPool   (DL_SHM_NULL)
+    , m_nSize   (0)
+{
+    ;   //  intentionally left blank
+}
+
+
+//  the destructor detaches from the segment, the
+//  elements stay in the list for the other processes
+//
+template <class DATATYPE> CdlShmList<DATATYPE>::~CdlShmList(void)
+{
+    Detach();
+}
+
+
+//  creates a new segment with room for 'nCapacity' elements and
+//  attaches to it. the list in the new segment is empty.
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::Create(const char* pszName, unsigned long nCapacity, unsigned long nTypeId)
+{
+    if ( (true == IsAttached()) || (0 == nCapacity) )
+    {
+        return false;
+    }
+
+    //  the size of the segment must neither overflow
+    //  size_t nor the off_t passed to ftruncate()
+    //
+    const size_t nMaxSize = static_cast<size_t>(-1);
+
+    if (nCapacity > (nMaxSize - HeaderSize()) / sizeof(CdlShmNode<DATATYPE>))
+    {
+        return false;
+    }
+
+    size_t nSize = HeaderSize() + nCapacity * sizeof(CdlShmNode<DATATYPE>);
+
+    if ( (static_cast<off_t>(nSize) < 0) || (static_cast<size_t>(static_cast<off_t>(nSize)) != nSize) )
+    {
+        return false;
+    }
+
+    //  O_EXCL makes sure, that no other process
+    //  is using the segment while it is initialized
+    //
+    int nFile = shm_open(pszName, O_RDWR | O_CREAT | O_EXCL, 0600);
+
+    if (-1 == nFile)
+    {
+        return false;
+    }
+
+    if ( (0 != ftruncate(nFile, static_cast<off_t>(nSize))) || (false == Map(nFile, nSize)) )
+    {
+        close(nFile);
+        shm_unlink(pszName);
+        return false;
+    }
+
+    close(nFile);
+
+    //  the mutex has to work across processes and it must survive
+    //  the death of a process that is holding it
+    //
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+
+    int nResult = pthread_mutex_init(&m_pHeader->mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    if (0 != nResult)
+    {
+        Unmap();
+        shm_unlink(pszName);
+
+        return false;
+    }
+
+    //  an empty list, the whole pool is unused
+    //
+    m_pHeader->nNodeSize  = sizeof(CdlShmNode<DATATYPE>);
+    m_pHeader->nDataSize  = sizeof(DATATYPE);
+    m_pHeader->nDataAlign = DataAlign();
+    m_pHeader->nTypeId    = TypeId(nTypeId);
+    m_pHeader->nCapacity  = nCapacity;
+    m_pHeader->nUsed      = 0L;
+    m_pHeader->nAttached  = 1L;
+    m_pHeader->nCounter   = 0L;
+    m_pHeader->nDamaged   = 0L;
+    m_pHeader->nFirst     = 0;
+    m_pHeader->nLast      = 0;
+    m_pHeader->nFree      = 0;
+
+    //  the magic number is written last, Attach() refuses
+    //  to use a segment that has not been initialized yet
+    //
+    __sync_synchronize();
+    m_pHeader->nMagic = DL_SHM_MAGIC;
+
+    return true;
+}
+
+
+//  attaches to a segment that was created by Create()
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::Attach(const char* pszName, unsigned long nTypeId)
+{
+    if (true == IsAttached())
+    {
+        return false;
+    }
+
+    int nFile = shm_open(pszName, O_RDWR, 0);
+
+    if (-1 == nFile)
+    {
+        return false;
+    }
+
+    //  the size of the segment is needed for the mapping and it must
+    //  at least be big enough to hold the header
+    //
+    struct stat info;
+
+    if ( (0 != fstat(nFile, &info))
+      || (static_cast<size_t>(info.st_size) < HeaderSize())
+      || (false == Map(nFile, static_cast<size_t>(info.st_size))) )
+    {
+        close(nFile);
+        return false;
+    }
+
+    close(nFile);
+
+    //  the segment must be initialized and has to
+    //  be created for lists of the same DATATYPE
+    //
+    __sync_synchronize();
+
+    if ( (DL_SHM_MAGIC != m_pHeader->nMagic)
+      || (sizeof(CdlShmNode<DATATYPE>) != m_pHeader->nNodeSize)
+      || (sizeof(DATATYPE) != m_pHeader->nDataSize)
+      || (DataAlign() != m_pHeader->nDataAlign)
+      || (TypeId(nTypeId) != m_pHeader->nTypeId)
+      || (m_pHeader->nCapacity > (m_nSize - HeaderSize()) / m_pHeader->nNodeSize)
+      || (false == LockSegment()) )
+    {
+        Unmap();
+        return false;
+    }
+
+    m_pHeader->nAttached++;
+    Unlock();
+
+    return true;
+}
+
+
+//  detaches from the segment. the segment and the elements
+//  in it persist until the segment is removed by Unlink()
+//
+template <class DATATYPE>
+void CdlShmList<DATATYPE>::Detach(void)
+{
+    if (true == IsAttached())
+    {
+        if (true == LockSegment())
+        {
+            m_pHeader->nAttached--;
+            Unlock();
+        }
+
+        Unmap();
+    }
+}
+
+
+//  removes the name of a segment. the memory is
+//  released after the last process has detached.
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::Unlink(const char* pszName)
+{
+    return static_cast<bool>(0 == shm_unlink(pszName));
+}
+
+
+//  maps 'nSize' bytes of an opened segment
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::Map(int nFile, size_t nSize)
+{
+    void* pMapping = mmap(0, nSize, PROT_READ | PROT_WRITE, MAP_SHARED, nFile, 0);
+
+    if (MAP_FAILED == pMapping)
+    {
+        return false;
+    }
+
+    m_pHeader = static_cast<DL_SHM_HEADER*>(pMapping);
+    m_pPool   = (CdlShmNode<DATATYPE>*)((char*)(pMapping) + HeaderSize());
+    m_nSize   = nSize;
+
+    return true;
+}
+
+
+//  unmaps the segment and resets the members
+//
+template <class DATATYPE>
+void CdlShmList<DATATYPE>::Unmap(void)
+{
+    munmap(m_pHeader, m_nSize);
+
+    m_pHeader = 0;
+    m_pPool   = DL_SHM_NULL;
+    m_nSize   = 0;
+}
+
+
+//  locks the mutex of the segment. when the previous owner died while
+//  holding it, the lock is taken over and the mutex is made consistent
+//  again. the list itself might have been left in the middle of an
+//  operation, so it is marked as damaged in that case.
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::LockSegment(void) const
+{
+    if (false == IsAttached())
+    {
+        return false;
+    }
+
+    int nResult = pthread_mutex_lock(&m_pHeader->mutex);
+
+    if (EOWNERDEAD == nResult)
+    {
+        m_pHeader->nDamaged = 1L;
+        nResult = pthread_mutex_consistent(&m_pHeader->mutex);
+
+        if (0 != nResult)
+        {
+            pthread_mutex_unlock(&m_pHeader->mutex);
+        }
+    }
+
+    return static_cast<bool>(0 == nResult);
+}
+
+
+//  locks the mutex of the segment, but only
+//  as long as the list is not damaged
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::Lock(void) const
+{
+    if (false == LockSegment())
+    {
+        return false;
+    }
+
+    if (0L != m_pHeader->nDamaged)
+    {
+        Unlock();
+        return false;
+    }
+
+    return true;
+}
+
+
+//  unlocks the mutex of the segment
+//
+template <class DATATYPE>
+void CdlShmList<DATATYPE>::Unlock(void) const
+{
+    if (true == IsAttached())
+    {
+        pthread_mutex_unlock(&m_pHeader->mutex);
+    }
+}
+
+
+//  returns true when a process died while holding the mutex
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::IsDamaged(void) const
+{
+    if (false == LockSegment())
+    {
+        return false;
+    }
+
+    bool bDamaged = static_cast<bool>(0L != m_pHeader->nDamaged);
+    Unlock();
+
+    return bDamaged;
+}
+
+
+//  empties the list by resetting the pool and clears the damaged mark.
+//  the links of a damaged list can not be trusted, so the elements
+//  are dropped. returns false when the mutex can not be locked.
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::Reset(void)
+{
+    if (false == LockSegment())
+    {
+        return false;
+    }
+
+    m_pHeader->nFirst   = 0;
+    m_pHeader->nLast    = 0;
+    m_pHeader->nFree    = 0;
+    m_pHeader->nUsed    = 0L;
+    m_pHeader->nCounter = 0L;
+    m_pHeader->nDamaged = 0L;
+
+    Unlock();
+
+    return true;
+}
+
+
+//  takes a node from the free list, or when that is empty, the next
+//  never used node from the pool. returns DL_SHM_NULL when the pool
+//  is exhausted.
+//
+template <class DATATYPE>
+CdlShmNode<DATATYPE>* CdlShmList<DATATYPE>::AllocNode(const DATATYPE& data)
+{
+    CdlShmNode<DATATYPE>* pNew = CdlShmNode<DATATYPE>::FromOffset(&m_pHeader->nFree);
+
+    if (DL_SHM_NULL != pNew)
+    {
+        m_pHeader->nFree = CdlShmNode<DATATYPE>::ToOffset(&m_pHeader->nFree, pNew->GetPrev());
+    }
+
+    else if (m_pHeader->nUsed < m_pHeader->nCapacity)
+    {
+        pNew = m_pPool + m_pHeader->nUsed;
+        m_pHeader->nUsed++;
+    }
+
+    else
+    {
+        return DL_SHM_NULL;
+    }
+
+    pNew->m_nPrev = 0;
+    pNew->m_nNext = 0;
+
+    //  copy the data to the elements member
+    //
+    memmove( &pNew->m_data, &data, sizeof(DATATYPE) );
+
+    return pNew;
+}
+
+
+//  puts a node that has been cut out from the list into the free list
+//
+template <class DATATYPE>
+void CdlShmList<DATATYPE>::FreeNode(CdlShmNode<DATATYPE>* pNode)
+{
+    pNode->SetPrev(CdlShmNode<DATATYPE>::FromOffset(&m_pHeader->nFree));
+    pNode->m_nNext = DL_SHM_FREE;
+
+    m_pHeader->nFree = CdlShmNode<DATATYPE>::ToOffset(&m_pHeader->nFree, pNode);
+}
+
+
+//  creates and adds a new element at the start of the list
+//
+template <class DATATYPE>
+DL_POSITION CdlShmList<DATATYPE>::AddFirst(const DATATYPE& data)
+{
+    if (false == IsAttached())
+    {
+        return PositionFromNode(DL_SHM_NULL);
+    }
+
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return PositionFromNode(DL_SHM_NULL);
+    }
+
+    CdlShmNode<DATATYPE> *pNew = AllocNode(data);
+
+    if (DL_SHM_NULL != pNew)
+    {
+        //  the original first node will be the new ones previous node
+        //
+        pNew->SetPrev(First());
+        SetFirstNode(pNew);
+
+        //  link the original first node back to the new one,
+        //  or make the new node the last one in an empty list
+        //
+        (DL_SHM_NULL != pNew->GetPrev())
+            ? pNew->GetPrev()->SetNext(pNew)
+            : SetLastNode(pNew);
+
+        m_pHeader->nCounter++;
+    }
+
+    return PositionFromNode(pNew);
+}
+
+
+//  creates a new node and appends it to the end of the list
+//
+template <class DATATYPE>
+DL_POSITION CdlShmList<DATATYPE>::AddLast(const DATATYPE& data)
+{
+    if (false == IsAttached())
+    {
+        return PositionFromNode(DL_SHM_NULL);
+    }
+
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return PositionFromNode(DL_SHM_NULL);
+    }
+
+    CdlShmNode<DATATYPE> *pNew = AllocNode(data);
+
+    if (DL_SHM_NULL != pNew)
+    {
+        //  the original last node will be the new ones next node
+        //
+        pNew->SetNext(Last());
+        SetLastNode(pNew);
+
+        //  link the original last node to the new one, or
+        //  make the new node the first one in an empty list
+        //
+        (DL_SHM_NULL != pNew->GetNext())
+            ? pNew->GetNext()->SetPrev(pNew)
+            : SetFirstNode(pNew);
+
+        m_pHeader->nCounter++;
+    }
+
+    return PositionFromNode(pNew);
+}
+
+
+//  creates and adds a new element after a given position
+//
+template <class DATATYPE>
+DL_POSITION CdlShmList<DATATYPE>::AddAfter(const DATATYPE& data, const DL_POSITION position)
+{
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return PositionFromNode(DL_SHM_NULL);
+    }
+
+    if (false == IsValidPosition(position))
+    {
+        return PositionFromNode(DL_SHM_NULL);
+    }
+
+    CdlShmNode<DATATYPE>* pPosition = NodeFromPosition(position);
+
+    if (pPosition->IsLast())
+    {
+        return AddLast(data);
+    }
+
+    CdlShmNode<DATATYPE> *pNew = AllocNode(data);
+
+    if (DL_SHM_NULL != pNew)
+    {
+        //  pPosition is not the last node, so it has a previous one
+        //
+        pPosition->GetPrev()->SetNext(pNew);
+        pNew->SetPrev(pPosition->GetPrev());
+
+        pPosition->SetPrev(pNew);
+        pNew->SetNext(pPosition);
+
+        m_pHeader->nCounter++;
+    }
+
+    return PositionFromNode(pNew);
+}
+
+
+//  creates a new node and inserts it previous to a given position
+//
+template <class DATATYPE>
+DL_POSITION CdlShmList<DATATYPE>::AddBefore(const DATATYPE& data, const DL_POSITION position)
+{
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return PositionFromNode(DL_SHM_NULL);
+    }
+
+    if (false == IsValidPosition(position))
+    {
+        return PositionFromNode(DL_SHM_NULL);
+    }
+
+    CdlShmNode<DATATYPE>* pPosition = NodeFromPosition(position);
+
+    if (pPosition->IsFirst())
+    {
+        return AddFirst(data);
+    }
+
+    CdlShmNode<DATATYPE> *pNew = AllocNode(data);
+
+    if (DL_SHM_NULL != pNew)
+    {
+        //  pPosition is not the first node, so it has a next one
+        //
+        pPosition->GetNext()->SetPrev(pNew);
+        pNew->SetNext(pPosition->GetNext());
+
+        pPosition->SetNext(pNew);
+        pNew->SetPrev(pPosition);
+
+        m_pHeader->nCounter++;
+    }
+
+    return PositionFromNode(pNew);
+}
+
+
+//  returns a position value for the first element
+//
+template <class DATATYPE>
+DL_POSITION CdlShmList<DATATYPE>::GetFirstPosition(void)
+{
+    if (false == IsAttached())
+    {
+        return PositionFromNode(DL_SHM_NULL);
+    }
+
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return PositionFromNode(DL_SHM_NULL);
+    }
+
+    return PositionFromNode(First());
+}
+
+
+//  returns a position value for the last element
+//
+template <class DATATYPE>
+DL_POSITION CdlShmList<DATATYPE>::GetLastPosition(void)
+{
+    if (false == IsAttached())
+    {
+        return PositionFromNode(DL_SHM_NULL);
+    }
+
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return PositionFromNode(DL_SHM_NULL);
+    }
+
+    return PositionFromNode(Last());
+}
+
+
+//  returns a position value next to a given one, which
+//  is the one linked by m_nPrev (see CdlShmNode)
+//
+template <class DATATYPE>
+DL_POSITION CdlShmList<DATATYPE>::GetNextPosition(const DL_POSITION position)
+{
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return PositionFromNode(DL_SHM_NULL);
+    }
+
+    return (false == IsValidPosition(position))
+        ? PositionFromNode(DL_SHM_NULL)
+        : PositionFromNode(NodeFromPosition(position)->GetPrev());
+}
+
+
+//  returns a position value previous to a given one
+//
+template <class DATATYPE>
+DL_POSITION CdlShmList<DATATYPE>::GetPreviousPosition(const DL_POSITION position)
+{
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return PositionFromNode(DL_SHM_NULL);
+    }
+
+    return (false == IsValidPosition(position))
+        ? PositionFromNode(DL_SHM_NULL)
+        : PositionFromNode(NodeFromPosition(position)->GetNext());
+}
+
+
+//  overwrites the data of the first element
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::SetFirst(const DATATYPE& data)
+{
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return false;
+    }
+
+    return (false == IsEmpty())
+        ? memmove(&First()->m_data, &data, sizeof(DATATYPE)), true
+        : false;
+}
+
+
+//  overwrites the data of the last element
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::SetLast(const DATATYPE& data)
+{
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return false;
+    }
+
+    return (false == IsEmpty())
+        ? memmove(&Last()->m_data, &data, sizeof(DATATYPE)), true
+        : false;
+}
+
+
+//  overwrites the data of an element given by its position
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::SetAt(const DATATYPE& data, const DL_POSITION position)
+{
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return false;
+    }
+
+    return (true == IsValidPosition(position))
+        ? memmove(&NodeFromPosition(position)->m_data, &data, sizeof(DATATYPE)), true
+        : false;
+}
+
+
+//  copies the data of the first element into a given reference
+//  returns false when the list is empty
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::GetFirst(DATATYPE& rValue)
+{
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return false;
+    }
+
+    return (false == IsEmpty())
+        ? memmove(&rValue, &First()->m_data, sizeof(DATATYPE)), true
+        : false;
+}
+
+
+//  copies the data of the last element into a given reference
+//  returns false when the list is empty
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::GetLast(DATATYPE& rValue)
+{
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return false;
+    }
+
+    return (false == IsEmpty())
+        ? memmove(&rValue, &Last()->m_data, sizeof(DATATYPE)), true
+        : false;
+}
+
+
+//  copies the data of an element give by its position into a reference
+//  returns false when the passed position is invalid
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::GetAt(DATATYPE& rValue, const DL_POSITION position)
+{
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return false;
+    }
+
+    return (true == IsValidPosition(position))
+        ? memmove(&rValue, &NodeFromPosition(position)->m_data, sizeof(DATATYPE)), true
+        : false;
+}
+
+
+//  deletes the first node of the list
+//  returns false when list is empty
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::DeleteFirst(void)
+{
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return false;
+    }
+
+    if (true == IsEmpty())
+    {
+        return false;
+    }
+
+    CdlShmNode<DATATYPE> *pDelete = First();
+
+    //  make the previous node the new first one, this
+    //  will be zero if it was the only node of the list
+    //
+    SetFirstNode(pDelete->GetPrev());
+
+    (DL_SHM_NULL != First())
+        ? First()->m_nNext = 0
+        : m_pHeader->nLast = 0;
+
+    FreeNode(pDelete);
+    m_pHeader->nCounter--;
+
+    return true;
+}
+
+
+//  deletes the last node of the list
+//  returns false when list is empty
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::DeleteLast(void)
+{
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return false;
+    }
+
+    if (true == IsEmpty())
+    {
+        return false;
+    }
+
+    CdlShmNode<DATATYPE> *pDelete = Last();
+
+    //  make the next node the new last one, this
+    //  will be zero if it was the only node of the list
+    //
+    SetLastNode(pDelete->GetNext());
+
+    (DL_SHM_NULL != Last())
+        ? Last()->m_nPrev   = 0
+        : m_pHeader->nFirst = 0;
+
+    FreeNode(pDelete);
+    m_pHeader->nCounter--;
+
+    return true;
+}
+
+
+//  deletes a node given by position from the list
+//  returns false when list is empty or on an invalid position
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::DeleteAt(const DL_POSITION position)
+{
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return false;
+    }
+
+    if (false == IsValidPosition(position))
+    {
+        return false;
+    }
+
+    CdlShmNode<DATATYPE> *pDelete = NodeFromPosition(position);
+
+    if (pDelete->IsFirst())
+    {
+        return DeleteFirst();
+    }
+
+    else if (pDelete->IsLast())
+    {
+        return DeleteLast();
+    }
+
+    //  link the previous and the next
+    //  node in order to cut this one out
+    //
+    pDelete->GetNext()->SetPrev(pDelete->GetPrev());
+    pDelete->GetPrev()->SetNext(pDelete->GetNext());
+
+    FreeNode(pDelete);
+    m_pHeader->nCounter--;
+
+    return true;
+}
+
+
+//  deletes all elements by resetting the pool, there
+//  is no need to run through the list for that
+//
+template <class DATATYPE>
+void CdlShmList<DATATYPE>::DeleteAll(void)
+{
+    if (false == IsAttached())
+    {
+        return;
+    }
+
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return;
+    }
+
+    m_pHeader->nFirst   = 0;
+    m_pHeader->nLast    = 0;
+    m_pHeader->nFree    = 0;
+    m_pHeader->nUsed    = 0L;
+    m_pHeader->nCounter = 0L;
+}
+
+
+//  returns the number of elements in the list
+//
+template <class DATATYPE>
+unsigned long CdlShmList<DATATYPE>::GetCount(void) const
+{
+    if (false == IsAttached())
+    {
+        return 0L;
+    }
+
+    CdlShmGuard guard(*this);
+
+    if (false == guard.IsLocked())
+    {
+        return 0L;
+    }
+
+    return m_pHeader->nCounter;
+}
+
+
+//  returns the maximum number of elements in the list
+//
+template <class DATATYPE>
+unsigned long CdlShmList<DATATYPE>::GetCapacity(void) const
+{
+    return (true == IsAttached())
+        ? m_pHeader->nCapacity
+        : 0L;
+}
+
+
+//  returns the number of list objects attached to the segment, e.g. to
+//  let the last one call Unlink(). a process that ended without calling
+//  Detach() is still counted.
+//
+template <class DATATYPE>
+unsigned long CdlShmList<DATATYPE>::GetAttached(void) const
+{
+    if ( (false == IsAttached()) || (false == LockSegment()) )
+    {
+        return 0L;
+    }
+
+    unsigned long nAttached = m_pHeader->nAttached;
+    Unlock();
+
+    return nAttached;
+}
+
+
+//  returns true when the list is empty
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::IsEmpty(void) const
+{
+    return static_cast<bool>( !GetCount() );
+}
+
+
+//  returns true when the list is attached to a segment
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::IsAttached(void) const
+{
+    return static_cast<bool>( 0 != m_pHeader );
+}
+
+
+//  tests if a position is valid. unlike CdlList, the node pool makes it
+//  cheap to verify that a position points to a node in this segment.
+//  a position of a deleted node is rejected as long as the node is in the
+//  free list. once it has been reused by an Add methode, the position is
+//  valid again and refers to the new element.
+//
+template <class DATATYPE>
+bool CdlShmList<DATATYPE>::IsValidPosition(const DL_POSITION position)
+{
+    if ( (true == IsEmpty()) || (PositionFromNode(DL_SHM_NULL) == position) )
+    {
+        return false;
+    }
+
+    //  the position has to point to the start
+    //  of a node, that was taken from the pool
+    //
+    const char*  pTest   = (const char*)(position);
+    const char*  pPool   = (const char*)(m_pPool);
+    const size_t nOffset = static_cast<size_t>(pTest - pPool);
+
+    return static_cast<bool>( (pTest >= pPool)
+                           && (nOffset < m_pHeader->nUsed * sizeof(CdlShmNode<DATATYPE>))
+                           && (0 == nOffset % sizeof(CdlShmNode<DATATYPE>))
+                           && (false == NodeFromPosition(position)->IsFree()) );
+}
+
+
+//  accessors for the first and last node, which
+//  are linked by offsets in the segment header
+//
+template <class DATATYPE>
+CdlShmNode<DATATYPE>* CdlShmList<DATATYPE>::First(void) const
+{
+    return CdlShmNode<DATATYPE>::FromOffset(&m_pHeader->nFirst);
+}
+
+template <class DATATYPE>
+CdlShmNode<DATATYPE>* CdlShmList<DATATYPE>::Last(void) const
+{
+    return CdlShmNode<DATATYPE>::FromOffset(&m_pHeader->nLast);
+}
+
+template <class DATATYPE>
+void CdlShmList<DATATYPE>::SetFirstNode(const CdlShmNode<DATATYPE>* pNode)
+{
+    m_pHeader->nFirst = CdlShmNode<DATATYPE>::ToOffset(&m_pHeader->nFirst, pNode);
+}
+
+template <class DATATYPE>
+void CdlShmList<DATATYPE>::SetLastNode(const CdlShmNode<DATATYPE>* pNode)
+{
+    m_pHeader->nLast = CdlShmNode<DATATYPE>::ToOffset(&m_pHeader->nLast, pNode);
+}
+
+
+//  the alignment of DATATYPE, as the offset of a member behind a char
+//
+template <class DATATYPE>
+size_t CdlShmList<DATATYPE>::DataAlign(void)
+{
+    struct DL_ALIGN
+    {
+        char     c;
+        DATATYPE data;
+    };
+
+    return offsetof(DL_ALIGN, data);
+}
+
+
+//  returns the id passed by the caller, or when that is zero, a FNV-1a
+//  hash of the name of DATATYPE. a hash of zero is replaced by one.
+//
+template <class DATATYPE>
+unsigned long CdlShmList<DATATYPE>::TypeId(unsigned long nTypeId)
+{
+    if (0L != nTypeId)
+    {
+        return nTypeId;
+    }
+
+    unsigned long nHash = 2166136261UL;
+
+    for (const char* pszName = typeid(DATATYPE).name(); '\0' != *pszName; pszName++)
+    {
+        nHash = ((nHash ^ static_cast<unsigned char>(*pszName)) * 16777619UL) & 0xFFFFFFFFUL;
+    }
+
+    return (0L != nHash) ? nHash : 1L;
+}
+
+
+//  the node pool starts behind the header, aligned for the nodes
+//
+template <class DATATYPE>
+size_t CdlShmList<DATATYPE>::HeaderSize(void)
+{
+    const size_t nAlign = 64;
+
+    return (sizeof(DL_SHM_HEADER) + nAlign - 1) / nAlign * nAlign;
+}
+
+
+//  casts an elements pointer to a DL_POSITION pointer
+//
+template <class DATATYPE>
+DL_POSITION CdlShmList<DATATYPE>::PositionFromNode(const CdlShmNode<DATATYPE>* pNode) const
+{
+    return (DL_POSITION)(pNode);
+}
+
+
+//  casts a DL_POSITION pointer to an element pointer
+//
+template <class DATATYPE>
+CdlShmNode<DATATYPE>* CdlShmList<DATATYPE>::NodeFromPosition(const DL_POSITION position) const
+{
+    return (CdlShmNode<DATATYPE>*)(position);
+}
+
+#endif  //  DL_CSHAREDMEMORYLIST_INCLUDED__
+
+//  end of file
@@ -0,0 +1,826 @@
+//=============================================================================
+//
+//  Copyright (c) 2004. Riccardo Riedl (www.riccardo-riedl.de)
+//
+//  Permission to use, copy, modify, distribute and sell this software and its
+//  documentation for any purpose is hereby granted without fee, provided that
+//  the above copyright notice appears in all copies and that both that
+//  copyright notice and this permission notice appear in supporting
+//  documentation.
+//
+//  There are no representations made about the suitability of this software
+//  for any purpose. It is provided "as is" without expressed or implied
+//  warranty.
+//
+//=============================================================================
+
+
+//=============================================================================
+//  preprocessor directives
+//=============================================================================
+
+//  include this file only once
+//
+#ifndef DL_CSKIPLIST_INCLUDED__
+#define DL_CSKIPLIST_INCLUDED__
+
+//  DL_POSITION type definition
+//
+#include "dlList.h"
+
+//  header file for placement new and std::nothrow
+//
+#include <new>
+
+//  symbol for null-pointer
+//
+#define DL_SKIP_NULL ( static_cast< CdlSkipNode<DATATYPE>* >( 0 ) )
+
+//  maximum number of levels. every level holds about a quarter
+//  of the nodes of the level below, so this is enough for 4^16
+//  elements before the search gets slower than O(log n)
+//
+#define DL_SKIP_MAXLEVEL ( 16 )
+
+
+//=============================================================================
+//  DL_LESS template structure
+//
+//  description:    default ordering of CdlSkipList, using operator<
+//=============================================================================
+
+template <class DATATYPE> struct DL_LESS
+{
+    bool operator()(const DATATYPE& left, const DATATYPE& right) const
+    {
+        return static_cast<bool>(left < right);
+    }
+};
+
+
+//=============================================================================
+//  CdlSkipNode template class
+//
+//  description:    The CdlSkipNode template class is the container for
+//                  elements of a CdlSkipList. m_pPrev and m_apNext[0] link
+//                  all nodes in both directions, the higher entries of
+//                  m_apNext skip over the nodes with fewer levels. unlike in
+//                  CdlNode, the next links point towards the end of the list.
+//=============================================================================
+
+//  forward decleration of the CdlSkipList template class,
+//  so that it can be declared as friend in CdlSkipNode
+//
+template <class DATATYPE, class LESS> class CdlSkipList;
+
+
+//=============================================================================
+//  class decleration
+//-----------------------------------------------------------------------------
+
+template <class DATATYPE> class CdlSkipNode
+{
+
+    template <class, class> friend class CdlSkipList;
+
+
+    //-------------------------------------------------------------------------
+    //  data members
+    //-------------------------------------------------------------------------
+
+private:
+
+    CdlSkipNode*  m_pPrev;      //  if DL_SKIP_NULL this is the first node
+    unsigned long m_nLevels;    //  number of entries in m_apNext
+
+    //  the data object to be stored in this node
+    //
+    DATATYPE m_data;
+
+    //  links to the next node on every level of this node. the node is
+    //  allocated with room for m_nLevels entries, so this has to be the
+    //  last member. if m_apNext[0] is DL_SKIP_NULL this is the last node
+    //
+    CdlSkipNode*  m_apNext[1];
+
+
+    //-------------------------------------------------------------------------
+    //  methodes
+    //-------------------------------------------------------------------------
+
+private:
+
+    //  the constructor copies the passed element,
+    //  the links are set by CdlSkipList
+    //
+    CdlSkipNode(const DATATYPE& data, unsigned long nLevels);
+
+    //  nodes have a variable size, so they are
+    //  created and deleted by those functions
+    //
+    static CdlSkipNode* Create (const DATATYPE& data, unsigned long nLevels);
+    static void         Destroy(CdlSkipNode* pNode);
+
+};
+
+
+//=============================================================================
+//  definitions
+//-----------------------------------------------------------------------------
+
+template <class DATATYPE>
+CdlSkipNode<DATATYPE>::CdlSkipNode(const DATATYPE& data, unsigned long nLevels)
+    : m_pPrev   (DL_SKIP_NULL)
+    , m_nLevels (nLevels)
+    , m_data    (data)
+{
+    ;   //  intentionally left blank
+}
+
+
+//  allocates a node with room for 'nLevels' next links
+//  returns DL_SKIP_NULL on failure
+//
+template <class DATATYPE>
+CdlSkipNode<DATATYPE>* CdlSkipNode<DATATYPE>::Create(const DATATYPE& data, unsigned long nLevels)
+{
+    void* pMemory = ::operator new(sizeof(CdlSkipNode) + (nLevels - 1) * sizeof(CdlSkipNode*), std::nothrow);
+
+    return (0 != pMemory)
+        ? new (pMemory) CdlSkipNode(data, nLevels)
+        : DL_SKIP_NULL;
+}
+
+
+//  destroys a node created by Create()
+//
+template <class DATATYPE>
+void CdlSkipNode<DATATYPE>::Destroy(CdlSkipNode<DATATYPE>* pNode)
+{
+    pNode->~CdlSkipNode();
+    ::operator delete(pNode);
+}
+
+
+
+//=============================================================================
+//  CdlSkipList template class
+//
+//  description:    doubly-linked list keeping its elements sorted. the
+//                  nodes get a random number of additional forward links
+//                  skipping over the nodes with fewer links, which makes
+//                  searching, inserting and deleting O(log n). the list can
+//                  be traversed with the positions just like a CdlList.
+//=============================================================================
+
+
+//=============================================================================
+//  class decleration
+//-----------------------------------------------------------------------------
+
+template <class DATATYPE, class LESS = DL_LESS<DATATYPE> >
+class CdlSkipList
+{
+
+    //-------------------------------------------------------------------------
+    //  data members
+    //-------------------------------------------------------------------------
+
+private:
+
+    //  links to the first node on every level (DL_SKIP_NULL if none)
+    //
+    CdlSkipNode<DATATYPE>* m_apHead[DL_SKIP_MAXLEVEL];
+
+    CdlSkipNode<DATATYPE>* m_pLast;     //  link to the last node  (DL_SKIP_NULL if list empty)
+
+    unsigned long m_nLevels;            //  number of levels in use, at least 1
+    unsigned long m_nCounter;           //  number of elements in the list
+    unsigned long m_nSeed;              //  state of the random level generator
+
+    LESS          m_less;               //  the ordering of the elements
+
+
+    //-------------------------------------------------------------------------
+    //  methodes
+    //-------------------------------------------------------------------------
+
+public:
+
+    CdlSkipList(const LESS& less = LESS());
+    ~CdlSkipList(void);
+
+
+private:
+
+    //  not copyable
+    //
+    CdlSkipList(const CdlSkipList&);
+    CdlSkipList& operator=(const CdlSkipList&);
+
+    //  casting functions
+    //
+    inline DL_POSITION            PositionFromNode(const CdlSkipNode<DATATYPE>* pNode)    const;
+    inline CdlSkipNode<DATATYPE>* NodeFromPosition(const DL_POSITION            position) const;
+
+    //  returns the first node not less than 'data', or with 'bUpper' the
+    //  first node greater than 'data'. when 'apUpdate' is given, it receives
+    //  the links pointing to that node (or behind it) on every level.
+    //
+    CdlSkipNode<DATATYPE>* Search(const DATATYPE& data, bool bUpper, CdlSkipNode<DATATYPE>** apUpdate[]) const;
+
+    //  fills 'apUpdate' with the links pointing to 'pNode'. returns
+    //  false when they do not point to the node, which happens for a
+    //  node of another list only, if at all.
+    //
+    bool FindLinks(const CdlSkipNode<DATATYPE>* pNode, CdlSkipNode<DATATYPE>** apUpdate[]) const;
+
+    //  cuts a node out of the list with the links from FindLinks() and deletes it
+    //
+    void Remove(CdlSkipNode<DATATYPE>* pNode, CdlSkipNode<DATATYPE>** apUpdate[]);
+
+    //  drops the empty levels at the top
+    //
+    inline void ShrinkLevels(void);
+
+    //  returns the number of levels for a new node
+    //
+    inline unsigned long RandomLevels(void);
+
+
+public:
+
+    //  adds a new element at its place in the order, behind all equal
+    //  elements. returns the position of the new element or DL_NULL
+    //  when the node could not be allocated.
+    //
+    DL_POSITION Insert(const DATATYPE& data);
+
+
+    //  searching. LowerBound() returns the position of the first element
+    //  not less than 'data', UpperBound() the position of the first one
+    //  greater than 'data'. both return DL_NULL when there is none.
+    //
+    DL_POSITION LowerBound(const DATATYPE& data) const;
+    DL_POSITION UpperBound(const DATATYPE& data) const;
+
+
+    //  methodes to get the DL_POSITION value for an element
+    //  they return DL_NULL when the list is empty, the last and/or first position in
+    //  the list has already been reached or the 'position' argument doesn't
+    //  point to a valid node
+    //
+    DL_POSITION GetFirstPosition    (void) const;
+    DL_POSITION GetLastPosition     (void) const;
+    DL_POSITION GetNextPosition     (const DL_POSITION position) const;
+    DL_POSITION GetPreviousPosition (const DL_POSITION position) const;
+
+
+    //  methodes to get the data of an element. there are no methodes to
+    //  overwrite the data, as that could break the order of the list
+    //
+    bool GetFirst (DATATYPE& rValue) const;
+    bool GetLast  (DATATYPE& rValue) const;
+    bool GetAt    (DATATYPE& rValue, const DL_POSITION position) const;
+
+
+    //  methodes to delete elements from the list
+    //  they return false when the list is empty or the 'position' argument
+    //  doesn't point to a valid node
+    //
+    bool DeleteFirst (void);
+    bool DeleteLast  (void);
+    void DeleteAll   (void);
+    bool DeleteAt    (const DL_POSITION position);
+
+    //  deletes all elements not less than 'from' and less than 'to'. the
+    //  range is cut out in O(log n), the nodes are released afterwards.
+    //  returns the number of deleted elements.
+    //
+    unsigned long DeleteRange(const DATATYPE& from, const DATATYPE& to);
+
+
+    //  queries to retrieve information about the list
+    //
+    inline unsigned long GetCount(void) const;
+    inline bool          IsEmpty (void) const;
+
+
+    //  verification
+    //
+    bool IsValidPosition(const DL_POSITION position) const;
+};
+
+
+//=============================================================================
+//  definitions
+//-----------------------------------------------------------------------------
+
+//  the constructor initzializes the list as empty
+//
+template <class DATATYPE, class LESS>
+CdlSkipList<DATATYPE, LESS>::CdlSkipList(const LESS& less)
+    : m_pLast    (DL_SKIP_NULL)
+    , m_nLevels  (1L)
+    , m_nCounter (0L)
+    , m_nSeed    (0x2545F491L)
+    , m_less     (less)
+{
+    for (unsigned long nLevel = 0; nLevel < DL_SKIP_MAXLEVEL; nLevel++)
+    {
+        m_apHead[nLevel] = DL_SKIP_NULL;
+    }
+}
+
+
+//  the destructor deletes all elements from the list
+//
+template <class DATATYPE, class LESS>
+CdlSkipList<DATATYPE, LESS>::~CdlSkipList(void)
+{
+    DeleteAll();
+}
+
+
+//  creates a new node and links it behind all elements
+//  less than or equal to the new one on each of its levels
+//
+template <class DATATYPE, class LESS>
+DL_POSITION CdlSkipList<DATATYPE, LESS>::Insert(const DATATYPE& data)
+{
+    CdlSkipNode<DATATYPE>** apUpdate[DL_SKIP_MAXLEVEL];
+
+    Search(data, true, apUpdate);
+
+    unsigned long nLevels = RandomLevels();
+
+    CdlSkipNode<DATATYPE>* pNew = CdlSkipNode<DATATYPE>::Create(data, nLevels);
+
+    if (DL_SKIP_NULL == pNew)
+    {
+        return PositionFromNode(DL_SKIP_NULL);
+    }
+
+    //  the levels not in use so far start at the head
+    //
+    for (; m_nLevels < nLevels; m_nLevels++)
+    {
+        apUpdate[m_nLevels] = &m_apHead[m_nLevels];
+    }
+
+    for (unsigned long nLevel = 0; nLevel < nLevels; nLevel++)
+    {
+        pNew->m_apNext[nLevel] = *apUpdate[nLevel];
+        *apUpdate[nLevel]      = pNew;
+    }
+
+    //  link the previous node, which is the previous one of the
+    //  following node or the last node when there is none
+    //
+    CdlSkipNode<DATATYPE>* pFollowing = pNew->m_apNext[0];
+
+    if (DL_SKIP_NULL != pFollowing)
+    {
+        pNew->m_pPrev       = pFollowing->m_pPrev;
+        pFollowing->m_pPrev = pNew;
+    }
+
+    else
+    {
+        pNew->m_pPrev = m_pLast;
+        m_pLast       = pNew;
+    }
+
+    m_nCounter++;
+
+    return PositionFromNode(pNew);
+}
+
+
+//  searches from the top level down, moving forward on each
+//  level as long as the next node is still in front of 'data'
+//
+template <class DATATYPE, class LESS>
+CdlSkipNode<DATATYPE>* CdlSkipList<DATATYPE, LESS>::Search(const DATATYPE& data, bool bUpper, CdlSkipNode<DATATYPE>** apUpdate[]) const
+{
+    CdlSkipNode<DATATYPE>** apForward = const_cast<CdlSkipNode<DATATYPE>**>(m_apHead);
+
+    for (unsigned long nLevel = m_nLevels; nLevel-- > 0; )
+    {
+        CdlSkipNode<DATATYPE>* pNext;
+
+        while ( (DL_SKIP_NULL != (pNext = apForward[nLevel]))
+             && ((bUpper) ? !m_less(data, pNext->m_data) : m_less(pNext->m_data, data)) )
+        {
+            apForward = pNext->m_apNext;
+        }
+
+        if (0 != apUpdate)
+        {
+            apUpdate[nLevel] = &apForward[nLevel];
+        }
+    }
+
+    return apForward[0];
+}
+
+
+//  the links pointing to a node are found by walking backwards from it.
+//  on every level the link is in the nearest node in front, that is tall
+//  enough for the level, or in the head. a search for the data would have
+//  to walk over all equal elements in front of the node instead.
+//
+template <class DATATYPE, class LESS>
+bool CdlSkipList<DATATYPE, LESS>::FindLinks(const CdlSkipNode<DATATYPE>* pNode, CdlSkipNode<DATATYPE>** apUpdate[]) const
+{
+    CdlSkipNode<DATATYPE>* pIterator = pNode->m_pPrev;
+
+    for (unsigned long nLevel = 0; nLevel < pNode->m_nLevels; nLevel++)
+    {
+        while ( (DL_SKIP_NULL != pIterator) && (pIterator->m_nLevels <= nLevel) )
+        {
+            pIterator = pIterator->m_pPrev;
+        }
+
+        apUpdate[nLevel] = (DL_SKIP_NULL != pIterator)
+            ? &pIterator->m_apNext[nLevel]
+            : const_cast<CdlSkipNode<DATATYPE>**>(&m_apHead[nLevel]);
+
+        if (pNode != *apUpdate[nLevel])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+//  cuts a node out of the list on all of its levels
+//
+template <class DATATYPE, class LESS>
+void CdlSkipList<DATATYPE, LESS>::Remove(CdlSkipNode<DATATYPE>* pNode, CdlSkipNode<DATATYPE>** apUpdate[])
+{
+    for (unsigned long nLevel = 0; nLevel < pNode->m_nLevels; nLevel++)
+    {
+        *apUpdate[nLevel] = pNode->m_apNext[nLevel];
+    }
+
+    (DL_SKIP_NULL != pNode->m_apNext[0])
+        ? pNode->m_apNext[0]->m_pPrev = pNode->m_pPrev
+        : m_pLast                     = pNode->m_pPrev;
+
+    CdlSkipNode<DATATYPE>::Destroy(pNode);
+    m_nCounter--;
+
+    ShrinkLevels();
+}
+
+
+//  drops the levels without any node, but keeps at least one
+//
+template <class DATATYPE, class LESS>
+void CdlSkipList<DATATYPE, LESS>::ShrinkLevels(void)
+{
+    while ( (m_nLevels > 1) && (DL_SKIP_NULL == m_apHead[m_nLevels - 1]) )
+    {
+        m_nLevels--;
+    }
+}
+
+
+//  every additional level is taken with a probability of 1/4
+//
+template <class DATATYPE, class LESS>
+unsigned long CdlSkipList<DATATYPE, LESS>::RandomLevels(void)
+{
+    unsigned long nLevels = 1L;
+
+    //  a simple linear congruential generator is good enough here,
+    //  only its higher bits are used
+    //
+    m_nSeed = (m_nSeed * 1103515245L + 12345L) & 0xFFFFFFFFL;
+
+    unsigned long nBits = m_nSeed;
+
+    while ( (nLevels < DL_SKIP_MAXLEVEL) && (0 == (nBits & 0xC0000000L)) )
+    {
+        nLevels++;
+        nBits = (nBits << 2) & 0xFFFFFFFFL;
+    }
+
+    return nLevels;
+}
+
+
+//  returns the position of the first element not less than 'data'
+//
+template <class DATATYPE, class LESS>
+DL_POSITION CdlSkipList<DATATYPE, LESS>::LowerBound(const DATATYPE& data) const
+{
+    return PositionFromNode(Search(data, false, 0));
+}
+
+
+//  returns the position of the first element greater than 'data'
+//
+template <class DATATYPE, class LESS>
+DL_POSITION CdlSkipList<DATATYPE, LESS>::UpperBound(const DATATYPE& data) const
+{
+    return PositionFromNode(Search(data, true, 0));
+}
+
+
+//  returns a position value for the first element
+//
+template <class DATATYPE, class LESS>
+DL_POSITION CdlSkipList<DATATYPE, LESS>::GetFirstPosition(void) const
+{
+    return PositionFromNode(m_apHead[0]);
+}
+
+
+//  returns a position value for the last element
+//
+template <class DATATYPE, class LESS>
+DL_POSITION CdlSkipList<DATATYPE, LESS>::GetLastPosition(void) const
+{
+    return PositionFromNode(m_pLast);
+}
+
+
+//  returns a position value next to a given one
+//
+template <class DATATYPE, class LESS>
+DL_POSITION CdlSkipList<DATATYPE, LESS>::GetNextPosition(const DL_POSITION position) const
+{
+    return (false == IsValidPosition(position))
+        ? PositionFromNode(DL_SKIP_NULL)
+        : PositionFromNode(NodeFromPosition(position)->m_apNext[0]);
+}
+
+
+//  returns a position value previous to a given one
+//
+template <class DATATYPE, class LESS>
+DL_POSITION CdlSkipList<DATATYPE, LESS>::GetPreviousPosition(const DL_POSITION position) const
+{
+    return (false == IsValidPosition(position))
+        ? PositionFromNode(DL_SKIP_NULL)
+        : PositionFromNode(NodeFromPosition(position)->m_pPrev);
+}
+
+
+//  copies the data of the first element into a given reference
+//  returns false when the list is empty
+//
+template <class DATATYPE, class LESS>
+bool CdlSkipList<DATATYPE, LESS>::GetFirst(DATATYPE& rValue) const
+{
+    return (false == IsEmpty())
+        ? rValue = m_apHead[0]->m_data, true
+        : false;
+}
+
+
+//  copies the data of the last element into a given reference
+//  returns false when the list is empty
+//
+template <class DATATYPE, class LESS>
+bool CdlSkipList<DATATYPE, LESS>::GetLast(DATATYPE& rValue) const
+{
+    return (false == IsEmpty())
+        ? rValue = m_pLast->m_data, true
+        : false;
+}
+
+
+//  copies the data of an element give by its position into a reference
+//  returns false when the passed position is invalid
+//
+template <class DATATYPE, class LESS>
+bool CdlSkipList<DATATYPE, LESS>::GetAt(DATATYPE& rValue, const DL_POSITION position) const
+{
+    return (true == IsValidPosition(position))
+        ? rValue = NodeFromPosition(position)->m_data, true
+        : false;
+}
+
+
+//  deletes the first node of the list. it is linked directly by the
+//  head on all of its levels, so there is no need to search for it
+//
+template <class DATATYPE, class LESS>
+bool CdlSkipList<DATATYPE, LESS>::DeleteFirst(void)
+{
+    if (true == IsEmpty())
+    {
+        return false;
+    }
+
+    CdlSkipNode<DATATYPE>** apUpdate[DL_SKIP_MAXLEVEL];
+
+    for (unsigned long nLevel = 0; nLevel < m_apHead[0]->m_nLevels; nLevel++)
+    {
+        apUpdate[nLevel] = &m_apHead[nLevel];
+    }
+
+    Remove(m_apHead[0], apUpdate);
+
+    return true;
+}
+
+
+//  deletes the last node of the list. it is known to be in
+//  the list, so it does not need to be verified
+//
+template <class DATATYPE, class LESS>
+bool CdlSkipList<DATATYPE, LESS>::DeleteLast(void)
+{
+    if (true == IsEmpty())
+    {
+        return false;
+    }
+
+    CdlSkipNode<DATATYPE>** apUpdate[DL_SKIP_MAXLEVEL];
+
+    FindLinks(m_pLast, apUpdate);
+    Remove(m_pLast, apUpdate);
+
+    return true;
+}
+
+
+//  deletes a node given by position from the list. like CdlList, the
+//  position is only searched for in debug mode (see IsValidPosition())
+//
+template <class DATATYPE, class LESS>
+bool CdlSkipList<DATATYPE, LESS>::DeleteAt(const DL_POSITION position)
+{
+    if (false == IsValidPosition(position))
+    {
+        return false;
+    }
+
+    CdlSkipNode<DATATYPE>** apUpdate[DL_SKIP_MAXLEVEL];
+    CdlSkipNode<DATATYPE>*  pDelete = NodeFromPosition(position);
+
+    if (false == FindLinks(pDelete, apUpdate))
+    {
+        return false;
+    }
+
+    Remove(pDelete, apUpdate);
+
+    return true;
+}
+
+
+//  cuts out a range on every level at once and releases its nodes
+//
+template <class DATATYPE, class LESS>
+unsigned long CdlSkipList<DATATYPE, LESS>::DeleteRange(const DATATYPE& from, const DATATYPE& to)
+{
+    CdlSkipNode<DATATYPE>** apFrom[DL_SKIP_MAXLEVEL];
+    CdlSkipNode<DATATYPE>** apTo  [DL_SKIP_MAXLEVEL];
+
+    CdlSkipNode<DATATYPE>* pFirst = Search(from, false, apFrom);
+    CdlSkipNode<DATATYPE>* pEnd   = Search(to,   false, apTo);
+
+    //  nothing to do, when the range is empty
+    //
+    if ( (DL_SKIP_NULL == pFirst) || (false == m_less(pFirst->m_data, to)) )
+    {
+        return 0L;
+    }
+
+    //  on every level the links in front of the range now point
+    //  to the node following the range on that level
+    //
+    for (unsigned long nLevel = 0; nLevel < m_nLevels; nLevel++)
+    {
+        *apFrom[nLevel] = *apTo[nLevel];
+    }
+
+    (DL_SKIP_NULL != pEnd)
+        ? pEnd->m_pPrev = pFirst->m_pPrev
+        : m_pLast       = pFirst->m_pPrev;
+
+    ShrinkLevels();
+
+    //  the nodes of the range are still linked on the lowest level
+    //
+    unsigned long nDeleted = 0L;
+
+    while (pFirst != pEnd)
+    {
+        CdlSkipNode<DATATYPE>* pDelete = pFirst;
+        pFirst = pFirst->m_apNext[0];
+
+        CdlSkipNode<DATATYPE>::Destroy(pDelete);
+        nDeleted++;
+    }
+
+    m_nCounter -= nDeleted;
+
+    return nDeleted;
+}
+
+
+//  deletes all nodes running along the lowest level
+//
+template <class DATATYPE, class LESS>
+void CdlSkipList<DATATYPE, LESS>::DeleteAll(void)
+{
+    CdlSkipNode<DATATYPE>* pDelete = m_apHead[0];
+
+    while (DL_SKIP_NULL != pDelete)
+    {
+        CdlSkipNode<DATATYPE>* pNext = pDelete->m_apNext[0];
+        CdlSkipNode<DATATYPE>::Destroy(pDelete);
+        pDelete = pNext;
+    }
+
+    //  reset the list
+    //
+    for (unsigned long nLevel = 0; nLevel < m_nLevels; nLevel++)
+    {
+        m_apHead[nLevel] = DL_SKIP_NULL;
+    }
+
+    m_pLast    = DL_SKIP_NULL;
+    m_nLevels  = 1L;
+    m_nCounter = 0L;
+}
+
+
+//  returns the number of elements in the list
+//
+template <class DATATYPE, class LESS>
+unsigned long CdlSkipList<DATATYPE, LESS>::GetCount(void) const
+{
+    return m_nCounter;
+}
+
+
+//  returns true when the list is empty
+//
+template <class DATATYPE, class LESS>
+bool CdlSkipList<DATATYPE, LESS>::IsEmpty(void) const
+{
+    return static_cast<bool>( !GetCount() );
+}
+
+
+//  tests if a position is valid. like CdlList this does only search
+//  for the node in debug mode. that costs O(log n) to find the first
+//  equal element and then walks over the equal ones up to the node.
+//
+template <class DATATYPE, class LESS>
+bool CdlSkipList<DATATYPE, LESS>::IsValidPosition(const DL_POSITION position) const
+{
+    if ( (true == IsEmpty()) || (PositionFromNode(DL_SKIP_NULL) == position) )
+    {
+        return false;
+    }
+
+    #ifndef _DEBUG
+
+        return true;
+
+    #else
+
+        const CdlSkipNode<DATATYPE>* pNode     = NodeFromPosition(position);
+        const CdlSkipNode<DATATYPE>* pIterator = Search(pNode->m_data, false, 0);
+
+        while ( (DL_SKIP_NULL != pIterator) && (pIterator != pNode) && (!m_less(pNode->m_data, pIterator->m_data)) )
+        {
+            pIterator = pIterator->m_apNext[0];
+        }
+
+        return static_cast<bool>( pIterator == pNode );
+
+    #endif  //  _DEBUG
+}
+
+
+//  casts an elements pointer to a DL_POSITION pointer
+//
+template <class DATATYPE, class LESS>
+DL_POSITION CdlSkipList<DATATYPE, LESS>::PositionFromNode(const CdlSkipNode<DATATYPE>* pNode) const
+{
+    return (DL_POSITION)(pNode);
+}
+
+
+//  casts a DL_POSITION pointer to an element pointer
+//
+template <class DATATYPE, class LESS>
+CdlSkipNode<DATATYPE>* CdlSkipList<DATATYPE, LESS>::NodeFromPosition(const DL_POSITION position) const
+{
+    return (CdlSkipNode<DATATYPE>*)(position);
+}
+
+#endif  //  DL_CSKIPLIST_INCLUDED__
+
+//  end of file
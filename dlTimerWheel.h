@@ -0,0 +1,390 @@
+//=============================================================================
+//
+//  Copyright (c) 2004. Riccardo Riedl (www.riccardo-riedl.de)
+//
+//  Permission to use, copy, modify, distribute and sell this software and its
+//  documentation for any purpose is hereby granted without fee, provided that
+//  the above copyright notice appears in all copies and that both that
+//  copyright notice and this permission notice appear in supporting
+//  documentation.
+//
+//  There are no representations made about the suitability of this software
+//  for any purpose. It is provided "as is" without expressed or implied
+//  warranty.
+//
+//=============================================================================
+
+
+//=============================================================================
+//  preprocessor directives
+//=============================================================================
+
+//  include this file only once
+//
+#ifndef DL_CTIMERWHEEL_INCLUDED__
+#define DL_CTIMERWHEEL_INCLUDED__
+
+//  the slots of the wheel are CdlList objects
+//
+#include "dlList.h"
+
+//  CHAR_BIT
+//
+#include <limits.h>
+
+//  number of bits of the time handled by one level of the wheel
+//  and the number of levels. the wheel covers timeouts up to
+//  2^(DL_WHEEL_BITS * DL_WHEEL_LEVELS) ticks, longer ones are
+//  moved down the levels until they fit. both can be defined
+//  before including this file, e.g. to test a small wheel.
+//
+#ifndef DL_WHEEL_BITS
+#define DL_WHEEL_BITS   ( 8 )
+#endif
+
+#ifndef DL_WHEEL_LEVELS
+#define DL_WHEEL_LEVELS ( 4 )
+#endif
+#define DL_WHEEL_SLOTS  ( 1UL << DL_WHEEL_BITS )
+#define DL_WHEEL_MASK   ( DL_WHEEL_SLOTS - 1 )
+
+//  the range of the wheel must fit into an unsigned long, so the
+//  compilation fails with a negative array size when it does not
+//
+typedef char DL_WHEEL_RANGE_CHECK[(DL_WHEEL_BITS * DL_WHEEL_LEVELS <= sizeof(unsigned long) * CHAR_BIT) ? 1 : -1];
+
+
+//=============================================================================
+//  CdlTimerWheel template class
+//
+//  description:    hierarchical timer wheel. every level has DL_WHEEL_SLOTS
+//                  slots, each of them covering one tick on the lowest
+//                  level and DL_WHEEL_SLOTS times the range of a slot of
+//                  the level below on the higher ones. scheduling and
+//                  cancelling a timer just links or unlinks it in a slot,
+//                  expired slots are handed to the caller as a whole.
+//
+//                  the time is measured in ticks of any unit the caller
+//                  chooses, it must only grow monotonously.
+//=============================================================================
+
+
+//=============================================================================
+//  class decleration
+//-----------------------------------------------------------------------------
+
+template <class DATATYPE> class CdlTimerWheel
+{
+
+    //-------------------------------------------------------------------------
+    //  types
+    //-------------------------------------------------------------------------
+
+public:
+
+    //  the element type of the slot lists, holding the data of
+    //  a timer together with its expiry time
+    //
+    struct DL_TIMER
+    {
+        DATATYPE      data;         //  the data passed to Schedule()
+        unsigned long nExpiry;      //  the time the timer expires
+        unsigned long nSlot;        //  index of the slot the timer is linked in
+        unsigned long nGeneration;  //  generation of the slot when linked in
+    };
+
+    //  list type of the slots and for the expired timers
+    //
+    typedef CdlList<DL_TIMER> CdlTimerList;
+
+
+    //-------------------------------------------------------------------------
+    //  data members
+    //-------------------------------------------------------------------------
+
+private:
+
+    //  the slots of all levels, level n starts at n * DL_WHEEL_SLOTS
+    //
+    CdlTimerList  m_slots[DL_WHEEL_LEVELS * DL_WHEEL_SLOTS];
+
+    //  the generation of every slot. it is counted up when the timers
+    //  of a slot expire, so Cancel() can tell expired timers apart from
+    //  the ones linked into the slot later on.
+    //
+    unsigned long m_anGeneration[DL_WHEEL_LEVELS * DL_WHEEL_SLOTS];
+
+    unsigned long m_nNext;      //  the next tick to be processed by Advance()
+    unsigned long m_nCounter;   //  number of scheduled timers
+
+
+    //-------------------------------------------------------------------------
+    //  methodes
+    //-------------------------------------------------------------------------
+
+public:
+
+    CdlTimerWheel(unsigned long nNow = 0L);
+
+
+private:
+
+    //  not copyable, the positions returned by Schedule() are bound to it
+    //
+    CdlTimerWheel(const CdlTimerWheel&);
+    CdlTimerWheel& operator=(const CdlTimerWheel&);
+
+    //  returns the index of the slot for an expiry time
+    //
+    unsigned long SlotFromExpiry(unsigned long nExpiry) const;
+
+    //  moves all timers of a slot down to the slots they belong to now.
+    //  returns the index of the slot in its level.
+    //
+    unsigned long Cascade(unsigned long nLevel);
+
+
+public:
+
+    //  adds a new timer expiring at 'nExpiry'. timers expiring before the
+    //  next tick to be processed (see GetTime()) expire with that tick.
+    //  returns the position of the timer to cancel it.
+    //
+    DL_POSITION Schedule(const DATATYPE& data, unsigned long nExpiry);
+
+    //  deletes a scheduled timer. 'position' must have been returned by
+    //  Schedule(). returns false when the timer has expired already, as
+    //  long as it has not been deleted from the list passed to Advance().
+    //
+    bool Cancel(const DL_POSITION position);
+
+    //  processes all ticks up to and including 'nNow' and moves the
+    //  slots with the expired timers to the end of 'rExpired', keeping
+    //  the positions of the timers. returns the number of expired timers.
+    //
+    unsigned long Advance(unsigned long nNow, CdlTimerList& rExpired);
+
+
+    //  queries to retrieve information about the wheel
+    //
+    inline unsigned long GetCount(void) const;
+    inline bool          IsEmpty (void) const;
+    inline unsigned long GetTime (void) const;
+};
+
+
+//=============================================================================
+//  definitions
+//-----------------------------------------------------------------------------
+
+//  the constructor initializes the wheel as empty,
+//  'nNow' will be the first tick to be processed
+//
+template <class DATATYPE> CdlTimerWheel<DATATYPE>::CdlTimerWheel(unsigned long nNow)
+    : m_nNext    (nNow)
+    , m_nCounter (0L)
+{
+    memset( m_anGeneration, 0, sizeof(m_anGeneration) );
+}
+
+
+//  creates a new timer and links it into its slot
+//
+template <class DATATYPE>
+DL_POSITION CdlTimerWheel<DATATYPE>::Schedule(const DATATYPE& data, unsigned long nExpiry)
+{
+    DL_TIMER timer;
+
+    memmove( &timer.data, &data, sizeof(DATATYPE) );
+    timer.nExpiry     = nExpiry;
+    timer.nSlot       = SlotFromExpiry(nExpiry);
+    timer.nGeneration = m_anGeneration[timer.nSlot];
+
+    DL_POSITION position = m_slots[timer.nSlot].AddLast(timer);
+
+    if (0 != position)
+    {
+        m_nCounter++;
+    }
+
+    return position;
+}
+
+
+//  removes a timer from its slot
+//
+template <class DATATYPE>
+bool CdlTimerWheel<DATATYPE>::Cancel(const DL_POSITION position)
+{
+    if (0 == position)
+    {
+        return false;
+    }
+
+    //  the timer knows its slot, so there is no need to search for it.
+    //  the timers of a slot keep it when they expire, but the generation
+    //  of the slot has moved on then.
+    //
+    const DL_TIMER& rTimer = CdlTimerList::ElementAt(position);
+    unsigned long   nSlot  = rTimer.nSlot;
+
+    if ( (nSlot >= DL_WHEEL_LEVELS * DL_WHEEL_SLOTS)
+      || (rTimer.nGeneration != m_anGeneration[nSlot])
+      || (false == m_slots[nSlot].DeleteAt(position)) )
+    {
+        return false;
+    }
+
+    m_nCounter--;
+
+    return true;
+}
+
+
+//  processes the ticks from m_nNext to 'nNow'
+//
+template <class DATATYPE>
+unsigned long CdlTimerWheel<DATATYPE>::Advance(unsigned long nNow, CdlTimerList& rExpired)
+{
+    unsigned long nExpired = 0L;
+
+    while (m_nNext <= nNow)
+    {
+        //  without timers there is nothing to do
+        //  for the remaining ticks
+        //
+        if (0L == m_nCounter)
+        {
+            m_nNext = nNow + 1;
+            break;
+        }
+
+        unsigned long nIndex = m_nNext & DL_WHEEL_MASK;
+
+        //  when the lowest level wraps around, the timers of the next
+        //  slot of the level above are due within the next round and
+        //  move down. this continues up, as long as the levels wrap.
+        //
+        if (0L == nIndex)
+        {
+            for (unsigned long nLevel = 1; nLevel < DL_WHEEL_LEVELS; nLevel++)
+            {
+                if (0L != Cascade(nLevel))
+                {
+                    break;
+                }
+            }
+        }
+
+        CdlTimerList& rSlot = m_slots[nIndex];
+
+        nExpired   += rSlot.GetCount();
+        m_nCounter -= rSlot.GetCount();
+
+        if (false == rSlot.IsEmpty())
+        {
+            m_anGeneration[nIndex]++;
+            rExpired.Splice(rSlot);
+        }
+
+        m_nNext++;
+    }
+
+    return nExpired;
+}
+
+
+//  moves the timers of the current slot of a level to the levels below
+//
+template <class DATATYPE>
+unsigned long CdlTimerWheel<DATATYPE>::Cascade(unsigned long nLevel)
+{
+    unsigned long nIndex = (m_nNext >> (nLevel * DL_WHEEL_BITS)) & DL_WHEEL_MASK;
+    CdlTimerList& rSlot  = m_slots[nLevel * DL_WHEEL_SLOTS + nIndex];
+
+    //  the nodes are moved, so the positions of the timers stay valid
+    //
+    DL_POSITION position;
+
+    while (0 != (position = rSlot.GetFirstPosition()))
+    {
+        DL_TIMER& rTimer = CdlTimerList::ElementAt(position);
+
+        rTimer.nSlot       = SlotFromExpiry(rTimer.nExpiry);
+        rTimer.nGeneration = m_anGeneration[rTimer.nSlot];
+        m_slots[rTimer.nSlot].MoveLast(rSlot, position);
+    }
+
+    return nIndex;
+}
+
+
+//  returns the slot a timer belongs to, depending on how far
+//  its expiry time is ahead of the next tick to be processed
+//
+template <class DATATYPE>
+unsigned long CdlTimerWheel<DATATYPE>::SlotFromExpiry(unsigned long nExpiry) const
+{
+    //  timers that are due already expire with the next tick
+    //
+    if (nExpiry < m_nNext)
+    {
+        return m_nNext & DL_WHEEL_MASK;
+    }
+
+    unsigned long nDelta = nExpiry - m_nNext;
+
+    for (unsigned long nLevel = 0; nLevel < DL_WHEEL_LEVELS - 1; nLevel++)
+    {
+        if (nDelta < (1UL << ((nLevel + 1) * DL_WHEEL_BITS)))
+        {
+            return nLevel * DL_WHEEL_SLOTS + ((nExpiry >> (nLevel * DL_WHEEL_BITS)) & DL_WHEEL_MASK);
+        }
+    }
+
+    //  timers beyond the range of the wheel go to the farthest slot
+    //  of the top level. they are placed again, when it cascades. the
+    //  range is built without shifting by the full width of the type,
+    //  which is undefined when the wheel covers all of unsigned long.
+    //
+    const unsigned long nLevel    = DL_WHEEL_LEVELS - 1;
+    const unsigned long nMaxDelta = (((1UL << (DL_WHEEL_LEVELS * DL_WHEEL_BITS - 1)) - 1) << 1) | 1;
+
+    if (nDelta > nMaxDelta)
+    {
+        nExpiry = m_nNext + nMaxDelta;
+    }
+
+    return nLevel * DL_WHEEL_SLOTS + ((nExpiry >> (nLevel * DL_WHEEL_BITS)) & DL_WHEEL_MASK);
+}
+
+
+//  returns the number of scheduled timers
+//
+template <class DATATYPE>
+unsigned long CdlTimerWheel<DATATYPE>::GetCount(void) const
+{
+    return m_nCounter;
+}
+
+
+//  returns true when no timer is scheduled
+//
+template <class DATATYPE>
+bool CdlTimerWheel<DATATYPE>::IsEmpty(void) const
+{
+    return static_cast<bool>( !GetCount() );
+}
+
+
+//  returns the next tick to be processed by Advance()
+//
+template <class DATATYPE>
+unsigned long CdlTimerWheel<DATATYPE>::GetTime(void) const
+{
+    return m_nNext;
+}
+
+#endif  //  DL_CTIMERWHEEL_INCLUDED__
+
+//  end of file
@@ -0,0 +1,713 @@
+//=============================================================================
+//
+//  Copyright (c) 2004. Riccardo Riedl (www.riccardo-riedl.de)
+//
+//  Permission to use, copy, modify, distribute and sell this software and its
+//  documentation for any purpose is hereby granted without fee, provided that
+//  the above copyright notice appears in all copies and that both that
+//  copyright notice and this permission notice appear in supporting
+//  documentation.
+//
+//  There are no representations made about the suitability of this software
+//  for any purpose. It is provided "as is" without expressed or implied
+//  warranty.
+//
+//=============================================================================
+
+
+//=============================================================================
+//  preprocessor directives
+//=============================================================================
+
+//  include this file only once
+//
+#ifndef DL_LISTCHECKER_INCLUDED__
+#define DL_LISTCHECKER_INCLUDED__
+
+#include "dlTrace.h"
+
+#include <list>
+
+//  number of input bytes Decode() takes for one operation
+//
+#define DL_CHECKER_OPSIZE   ( 3 )
+
+
+//=============================================================================
+//  CdlListChecker class
+//
+//  description:    differential test of CdlList. every operation is applied
+//                  to two CdlList objects and to two std::list models of
+//                  them, the results have to be the same. after every
+//                  operation both lists have to pass IsConsistent() and
+//                  must hold the same elements at the same positions as
+//                  the models, walked forwards and backwards.
+//
+//                  the operations are either decoded from arbitrary bytes
+//                  (see Decode()), which always gives a valid operation,
+//                  or are read from a trace, which is verified on the fly.
+//=============================================================================
+
+class CdlListChecker
+{
+
+    //-------------------------------------------------------------------------
+    //  types
+    //-------------------------------------------------------------------------
+
+private:
+
+    typedef std::list<DL_TRACEITEM> CdlModel;
+
+    //  what is known about every element ever added
+    //
+    struct DL_HANDLEINFO
+    {
+        unsigned long      nList;       //  0 or 1, 2 when deleted
+        CdlModel::iterator it;          //  the element in the model
+        size_t             nLive;       //  index in m_live[nList]
+        DL_POSITION        position;    //  position in the CdlList
+    };
+
+
+    //-------------------------------------------------------------------------
+    //  data members
+    //-------------------------------------------------------------------------
+
+private:
+
+    CdlTraceList                m_lists [2];
+    CdlModel                    m_models[2];
+    std::vector<unsigned long>  m_live  [2];    //  handles in each list
+    std::vector<DL_HANDLEINFO>  m_handles;      //  indexed by handle
+
+    unsigned long               m_nOps;         //  operations applied so far
+    char                        m_szError[256];
+
+
+    //-------------------------------------------------------------------------
+    //  methodes
+    //-------------------------------------------------------------------------
+
+public:
+
+    CdlListChecker(void)
+        : m_handles (1)
+        , m_nOps    (0L)
+    {
+        m_handles[0].nList = 2;
+        m_szError[0]       = '\0';
+    }
+
+    //  the reason why Apply() failed
+    //
+    const char* GetError(void) const { return m_szError; }
+
+    unsigned long GetOpCount(void) const { return m_nOps; }
+
+
+    //  turns DL_CHECKER_OPSIZE arbitrary bytes into an operation, that
+    //  only refers to elements in the lists. the first byte selects the
+    //  methode, the second one the list and the element, the third one
+    //  the value. the values are kept small, so that there are equal
+    //  elements for Unique().
+    //
+    void Decode(const unsigned char* pBytes, DL_TRACEOP& rOp) const
+    {
+        rOp.nOpcode = pBytes[0] % DL_OP_COUNT;
+        rOp.nList   = pBytes[1] & 1;
+        rOp.nHandle = 0L;
+        rOp.nValue  = pBytes[2] & 15;
+
+        //  MoveLast() takes the element from the other list
+        //
+        const std::vector<unsigned long>& live = (DL_OP_MOVELAST == rOp.nOpcode)
+            ? m_live[rOp.nList ^ 1]
+            : m_live[rOp.nList];
+
+        const unsigned long nPick = pBytes[1] >> 1;
+
+        if ( (true == TakesHandle(rOp.nOpcode)) && (127 != nPick) && (false == live.empty()) )
+        {
+            rOp.nHandle = live[nPick % live.size()];
+        }
+
+        if (DL_OP_COMPACTSTEP == rOp.nOpcode)
+        {
+            rOp.nValue = (pBytes[2] & 7) + 1;
+        }
+    }
+
+
+    //  applies an operation to the lists and the models and compares
+    //  them. returns false with a message in GetError() on a difference
+    //  or when the operation refers to an element that is not there.
+    //
+    bool Apply(const DL_TRACEOP& op)
+    {
+        m_nOps++;
+
+        if ( (op.nOpcode >= DL_OP_COUNT) || (op.nList > 1) )
+        {
+            return Fail("invalid operation");
+        }
+
+        const unsigned long nOther = op.nList ^ 1;
+        const unsigned long nOwner = (DL_OP_MOVELAST == op.nOpcode) ? nOther : op.nList;
+
+        if ( (0L != op.nHandle)
+          && ( (false == TakesHandle(op.nOpcode)) || (op.nHandle >= m_handles.size()) || (nOwner != m_handles[op.nHandle].nList) ) )
+        {
+            return Fail("the handle does not refer to an element of the list");
+        }
+
+        CdlTraceList&       list       = m_lists [op.nList];
+        CdlTraceList&       other      = m_lists [nOther];
+        CdlModel&           model      = m_models[op.nList];
+        CdlModel&           otherModel = m_models[nOther];
+        const DL_HANDLEINFO info       = m_handles[op.nHandle];
+        const DL_POSITION   position   = (0L != op.nHandle) ? info.position : 0;
+        const bool          bHandle    = static_cast<bool>(0L != op.nHandle);
+
+        DL_TRACEITEM item;
+
+        item.nValue  = op.nValue;
+        item.nHandle = m_handles.size();
+
+        switch (op.nOpcode)
+        {
+            case DL_OP_ADDFIRST:
+            case DL_OP_ADDLAST:
+            case DL_OP_ADDAFTER:
+            case DL_OP_ADDBEFORE:
+            {
+                DL_POSITION added = 0;
+
+                switch (op.nOpcode)
+                {
+                    case DL_OP_ADDFIRST:  added = list.AddFirst (item);           break;
+                    case DL_OP_ADDLAST:   added = list.AddLast  (item);           break;
+                    case DL_OP_ADDAFTER:  added = list.AddAfter (item, position); break;
+                    case DL_OP_ADDBEFORE: added = list.AddBefore(item, position); break;
+                }
+
+                const bool bExpected = static_cast<bool>( (DL_OP_ADDFIRST == op.nOpcode) || (DL_OP_ADDLAST == op.nOpcode) || bHandle );
+
+                if (static_cast<bool>(0 != added) != bExpected)
+                {
+                    return Fail("the result of the Add methode differs");
+                }
+
+                if (false == bExpected)
+                {
+                    break;
+                }
+
+                CdlModel::iterator it;
+
+                switch (op.nOpcode)
+                {
+                    case DL_OP_ADDFIRST:  it = model.insert(model.begin(), item);          break;
+                    case DL_OP_ADDLAST:   it = model.insert(model.end(), item);            break;
+                    case DL_OP_ADDAFTER:  it = info.it; it = model.insert(++it, item);     break;
+                    default:              it = model.insert(info.it, item);                break;
+                }
+
+                m_handles.push_back(DL_HANDLEINFO());
+                Link(item.nHandle, op.nList, it, added);
+                break;
+            }
+
+            case DL_OP_SETFIRST:
+            case DL_OP_SETLAST:
+            case DL_OP_SETAT:
+            {
+                bool bExpected;
+                bool bResult;
+
+                CdlModel::iterator it = model.end();
+
+                if (DL_OP_SETAT == op.nOpcode)
+                {
+                    bExpected = bHandle;
+                    it        = info.it;
+                }
+
+                else
+                {
+                    bExpected = static_cast<bool>( !model.empty() );
+
+                    if (true == bExpected)
+                    {
+                        it = (DL_OP_SETFIRST == op.nOpcode) ? model.begin() : --model.end();
+                    }
+                }
+
+                //  the element keeps its handle
+                //
+                if (true == bExpected)
+                {
+                    item.nHandle = it->nHandle;
+                }
+
+                switch (op.nOpcode)
+                {
+                    case DL_OP_SETFIRST: bResult = list.SetFirst(item);           break;
+                    case DL_OP_SETLAST:  bResult = list.SetLast (item);           break;
+                    default:             bResult = list.SetAt   (item, position); break;
+                }
+
+                if (bResult != bExpected)
+                {
+                    return Fail("the result of the Set methode differs");
+                }
+
+                if (true == bExpected)
+                {
+                    it->nValue = op.nValue;
+                }
+
+                break;
+            }
+
+            case DL_OP_GETFIRST:
+            case DL_OP_GETLAST:
+            case DL_OP_GETAT:
+            {
+                bool bExpected;
+                bool bResult;
+
+                CdlModel::iterator it = model.end();
+
+                if (DL_OP_GETAT == op.nOpcode)
+                {
+                    bExpected = bHandle;
+                    it        = info.it;
+                    bResult   = list.GetAt(item, position);
+                }
+
+                else
+                {
+                    bExpected = static_cast<bool>( !model.empty() );
+
+                    if (true == bExpected)
+                    {
+                        it = (DL_OP_GETFIRST == op.nOpcode) ? model.begin() : --model.end();
+                    }
+
+                    bResult = (DL_OP_GETFIRST == op.nOpcode)
+                        ? list.GetFirst(item)
+                        : list.GetLast (item);
+                }
+
+                if ( (bResult != bExpected)
+                  || ( (true == bExpected) && ( (item.nValue != it->nValue) || (item.nHandle != it->nHandle) ) ) )
+                {
+                    return Fail("the result of the Get methode differs");
+                }
+
+                break;
+            }
+
+            case DL_OP_GETNEXT:
+            case DL_OP_GETPREVIOUS:
+            {
+                DL_POSITION expected = 0;
+
+                if (true == bHandle)
+                {
+                    CdlModel::iterator it = info.it;
+
+                    if (DL_OP_GETNEXT == op.nOpcode)
+                    {
+                        if (model.end() != ++it)
+                        {
+                            expected = m_handles[it->nHandle].position;
+                        }
+                    }
+
+                    else if (model.begin() != it)
+                    {
+                        expected = m_handles[(--it)->nHandle].position;
+                    }
+                }
+
+                DL_POSITION result = (DL_OP_GETNEXT == op.nOpcode)
+                    ? list.GetNextPosition    (position)
+                    : list.GetPreviousPosition(position);
+
+                if (result != expected)
+                {
+                    return Fail("the result of GetNextPosition() or GetPreviousPosition() differs");
+                }
+
+                break;
+            }
+
+            case DL_OP_DELETEFIRST:
+            case DL_OP_DELETELAST:
+            case DL_OP_DELETEAT:
+            {
+                bool bExpected;
+                bool bResult;
+
+                CdlModel::iterator it = model.end();
+
+                if (DL_OP_DELETEAT == op.nOpcode)
+                {
+                    bExpected = bHandle;
+                    it        = info.it;
+                    bResult   = list.DeleteAt(position);
+                }
+
+                else
+                {
+                    bExpected = static_cast<bool>( !model.empty() );
+
+                    if (true == bExpected)
+                    {
+                        it = (DL_OP_DELETEFIRST == op.nOpcode) ? model.begin() : --model.end();
+                    }
+
+                    bResult = (DL_OP_DELETEFIRST == op.nOpcode)
+                        ? list.DeleteFirst()
+                        : list.DeleteLast ();
+                }
+
+                if (bResult != bExpected)
+                {
+                    return Fail("the result of the Delete methode differs");
+                }
+
+                if (true == bExpected)
+                {
+                    Unlink(it->nHandle);
+                    model.erase(it);
+                }
+
+                break;
+            }
+
+            case DL_OP_DELETEALL:
+            {
+                list.DeleteAll();
+
+                while (false == model.empty())
+                {
+                    Unlink(model.front().nHandle);
+                    model.pop_front();
+                }
+
+                break;
+            }
+
+            case DL_OP_REMOVEIF:
+            {
+                DL_TRACEMATCH match(op.nValue);
+                unsigned long nExpected = 0L;
+
+                for (CdlModel::iterator it = model.begin(); model.end() != it; )
+                {
+                    if (true == match(*it))
+                    {
+                        Unlink(it->nHandle);
+                        it = model.erase(it);
+                        nExpected++;
+                    }
+
+                    else
+                    {
+                        ++it;
+                    }
+                }
+
+                if (list.RemoveIf(match) != nExpected)
+                {
+                    return Fail("the result of RemoveIf() differs");
+                }
+
+                break;
+            }
+
+            case DL_OP_PARTITION:
+            {
+                DL_TRACEMATCH match(op.nValue);
+                unsigned long nExpected = 0L;
+
+                for (CdlModel::iterator it = model.begin(); model.end() != it; )
+                {
+                    CdlModel::iterator move = it++;
+
+                    if (true == match(*move))
+                    {
+                        otherModel.splice(otherModel.end(), model, move);
+                        Move(move->nHandle, nOther);
+                        nExpected++;
+                    }
+                }
+
+                if (list.Partition(match, other) != nExpected)
+                {
+                    return Fail("the result of Partition() differs");
+                }
+
+                //  the nodes in a block of Compact() have been copied
+                //
+                Rescan(nOther);
+                break;
+            }
+
+            case DL_OP_UNIQUE:
+            {
+                unsigned long nExpected = 0L;
+
+                if (false == model.empty())
+                {
+                    CdlModel::iterator kept = model.begin();
+                    CdlModel::iterator it   = kept;
+
+                    for (++it; model.end() != it; )
+                    {
+                        if (kept->nValue == it->nValue)
+                        {
+                            Unlink(it->nHandle);
+                            it = model.erase(it);
+                            nExpected++;
+                        }
+
+                        else
+                        {
+                            kept = it++;
+                        }
+                    }
+                }
+
+                if (list.Unique(DL_TRACEEQUAL()) != nExpected)
+                {
+                    return Fail("the result of Unique() differs");
+                }
+
+                break;
+            }
+
+            case DL_OP_SPLICE:
+            {
+                for (CdlModel::iterator it = otherModel.begin(); otherModel.end() != it; ++it)
+                {
+                    Move(it->nHandle, op.nList);
+                }
+
+                model.splice(model.end(), otherModel);
+                list.Splice(other);
+                break;
+            }
+
+            case DL_OP_MOVELAST:
+            {
+                DL_POSITION moved = list.MoveLast(other, position);
+
+                if (static_cast<bool>(0 != moved) != bHandle)
+                {
+                    return Fail("the result of MoveLast() differs");
+                }
+
+                if (true == bHandle)
+                {
+                    model.splice(model.end(), otherModel, info.it);
+                    Move(op.nHandle, op.nList);
+                    m_handles[op.nHandle].position = moved;
+                }
+
+                break;
+            }
+
+            case DL_OP_COMPACT:
+            {
+                if (false == list.Compact(Remap, this))
+                {
+                    return Fail("Compact() failed");
+                }
+
+                break;
+            }
+
+            case DL_OP_COMPACTSTEP:
+            {
+                list.CompactStep(static_cast<unsigned long>(op.nValue), Remap, this);
+                break;
+            }
+
+            case DL_OP_GETCOUNT:
+            {
+                if ( (list.GetCount() != model.size()) || (list.IsEmpty() != model.empty()) )
+                {
+                    return Fail("the result of GetCount() or IsEmpty() differs");
+                }
+
+                break;
+            }
+        }
+
+        return static_cast<bool>( (true == Verify(0)) && (true == Verify(1)) );
+    }
+
+
+private:
+
+    //  the methodes that get the position of an element
+    //
+    static bool TakesHandle(unsigned long nOpcode)
+    {
+        switch (nOpcode)
+        {
+            case DL_OP_ADDAFTER:
+            case DL_OP_ADDBEFORE:
+            case DL_OP_SETAT:
+            case DL_OP_GETAT:
+            case DL_OP_GETNEXT:
+            case DL_OP_GETPREVIOUS:
+            case DL_OP_DELETEAT:
+            case DL_OP_MOVELAST:
+                return true;
+        }
+
+        return false;
+    }
+
+    //  records the failure of an operation
+    //
+    bool Fail(const char* pszReason)
+    {
+        snprintf(m_szError, sizeof(m_szError), "operation %lu: %s", m_nOps, pszReason);
+        return false;
+    }
+
+    //  adds an element to the live handles of a list
+    //
+    void Link(unsigned long nHandle, unsigned long nList, CdlModel::iterator it, DL_POSITION position)
+    {
+        DL_HANDLEINFO& info = m_handles[nHandle];
+
+        info.nList    = nList;
+        info.it       = it;
+        info.nLive    = m_live[nList].size();
+        info.position = position;
+
+        m_live[nList].push_back(nHandle);
+    }
+
+    //  removes an element from the live handles of its list
+    //
+    void Unlink(unsigned long nHandle)
+    {
+        DL_HANDLEINFO&              info = m_handles[nHandle];
+        std::vector<unsigned long>& live = m_live[info.nList];
+
+        live[info.nLive] = live.back();
+        m_handles[live.back()].nLive = info.nLive;
+        live.pop_back();
+
+        info.nList = 2;
+    }
+
+    //  moves an element to the live handles of the other list, the
+    //  model iterator stays valid, as std::list::splice() keeps it
+    //
+    void Move(unsigned long nHandle, unsigned long nList)
+    {
+        DL_HANDLEINFO info = m_handles[nHandle];
+
+        Unlink(nHandle);
+        Link(nHandle, nList, info.it, info.position);
+    }
+
+    //  takes the positions of all elements of a list from the nodes
+    //
+    void Rescan(unsigned long nList)
+    {
+        CdlTraceList& list = m_lists[nList];
+
+        for (DL_POSITION position = list.GetFirstPosition(); 0 != position; position = list.GetNextPosition(position))
+        {
+            const unsigned long nHandle = CdlTraceList::ElementAt(position).nHandle;
+
+            if (nHandle < m_handles.size())
+            {
+                m_handles[nHandle].position = position;
+            }
+        }
+    }
+
+    //  called by Compact() and CompactStep() for every node moved
+    //
+    static void Remap(DL_POSITION, DL_POSITION newPosition, void* pContext)
+    {
+        CdlListChecker*     pChecker = static_cast<CdlListChecker*>(pContext);
+        const unsigned long nHandle  = CdlTraceList::ElementAt(newPosition).nHandle;
+
+        if (nHandle < pChecker->m_handles.size())
+        {
+            pChecker->m_handles[nHandle].position = newPosition;
+        }
+    }
+
+    //  compares a list with its model, in both directions
+    //
+    bool Verify(unsigned long nList)
+    {
+        CdlTraceList& list  = m_lists [nList];
+        CdlModel&     model = m_models[nList];
+
+        if (false == list.IsConsistent())
+        {
+            return Fail("IsConsistent() failed");
+        }
+
+        if (list.GetCount() != model.size())
+        {
+            return Fail("the number of elements differs");
+        }
+
+        DL_POSITION position = list.GetFirstPosition();
+
+        for (CdlModel::const_iterator it = model.begin(); model.end() != it; ++it)
+        {
+            if ( (0 == position) || (position != m_handles[it->nHandle].position) )
+            {
+                return Fail("the positions differ, walking forwards");
+            }
+
+            const DL_TRACEITEM& element = CdlTraceList::ElementAt(position);
+
+            if ( (element.nValue != it->nValue) || (element.nHandle != it->nHandle) )
+            {
+                return Fail("the elements differ");
+            }
+
+            position = list.GetNextPosition(position);
+        }
+
+        if (0 != position)
+        {
+            return Fail("the list is longer than the model");
+        }
+
+        position = list.GetLastPosition();
+
+        for (CdlModel::const_reverse_iterator it = model.rbegin(); model.rend() != it; ++it)
+        {
+            if ( (0 == position) || (position != m_handles[it->nHandle].position) )
+            {
+                return Fail("the positions differ, walking backwards");
+            }
+
+            position = list.GetPreviousPosition(position);
+        }
+
+        return static_cast<bool>( (0 == position) || Fail("the list is longer than the model, walking backwards") );
+    }
+};
+
+#endif  //  DL_LISTCHECKER_INCLUDED__
+
+//  end of file
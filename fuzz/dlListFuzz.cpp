@@ -0,0 +1,55 @@
+//=============================================================================
+//
+//  Copyright (c) 2004. Riccardo Riedl (www.riccardo-riedl.de)
+//
+//  Permission to use, copy, modify, distribute and sell this software and its
+//  documentation for any purpose is hereby granted without fee, provided that
+//  the above copyright notice appears in all copies and that both that
+//  copyright notice and this permission notice appear in supporting
+//  documentation.
+//
+//  There are no representations made about the suitability of this software
+//  for any purpose. It is provided "as is" without expressed or implied
+//  warranty.
+//
+//=============================================================================
+
+
+//=============================================================================
+//  dlListFuzz
+//
+//  description:    libFuzzer entry point. the input is cut into operations
+//                  of DL_CHECKER_OPSIZE bytes, which are run through
+//                  CdlListChecker. a difference to the model aborts.
+//
+//  usage:          build with -fsanitize=fuzzer,address,undefined (see
+//                  CMakeLists.txt) and run "dlListFuzz [corpus directory]"
+//=============================================================================
+
+#include "dlListChecker.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* pData, size_t nSize)
+{
+    CdlListChecker checker;
+    DL_TRACEOP     op;
+
+    for (size_t nOffset = 0; nOffset + DL_CHECKER_OPSIZE <= nSize; nOffset += DL_CHECKER_OPSIZE)
+    {
+        checker.Decode(pData + nOffset, op);
+
+        if (false == checker.Apply(op))
+        {
+            fprintf(stderr, "%s (%s %lu %lu %ld)\n", checker.GetError(),
+                    g_aszTraceNames[op.nOpcode], op.nList, op.nHandle, op.nValue);
+            abort();
+        }
+    }
+
+    return 0;
+}
+
+//  end of file
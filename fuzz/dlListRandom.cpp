@@ -0,0 +1,242 @@
+//=============================================================================
+//
+//  Copyright (c) 2004. Riccardo Riedl (www.riccardo-riedl.de)
+//
+//  Permission to use, copy, modify, distribute and sell this software and its
+//  documentation for any purpose is hereby granted without fee, provided that
+//  the above copyright notice appears in all copies and that both that
+//  copyright notice and this permission notice appear in supporting
+//  documentation.
+//
+//  There are no representations made about the suitability of this software
+//  for any purpose. It is provided "as is" without expressed or implied
+//  warranty.
+//
+//=============================================================================
+
+
+//=============================================================================
+//  dlListRandom
+//
+//  description:    plain random driver for CdlListChecker, for compilers
+//                  without libFuzzer. every run decodes random bytes into
+//                  operations and checks them against the model. the
+//                  operations are drawn from a mix, which can also be
+//                  recorded as a trace for dlListReplay.
+//
+//  usage:          dlListRandom [-seed n] [-runs n] [-ops n] [-mix name]
+//                               [-record file]
+//                  dlListRandom -verify file
+//
+//                  -seed    first seed, every run uses the next one
+//                  -runs    number of runs, each with new lists
+//                  -ops     number of operations per run
+//                  -mix     uniform, queue or edit (see g_aMixes)
+//                  -record  writes the operations of the first run
+//                  -verify  checks a recorded trace against the model
+//=============================================================================
+
+#include "dlListChecker.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+//=============================================================================
+//  operation mixes
+//-----------------------------------------------------------------------------
+
+//  the weight of every operation in a mix, in the order of DL_TRACEOPCODE
+//
+struct DL_MIX
+{
+    const char*   pszName;
+    unsigned char anWeights[DL_OP_COUNT];
+};
+
+static const DL_MIX g_aMixes[] =
+{
+    //  every operation equally often
+    //
+    { "uniform", { 1, 1, 1, 1,  1, 1, 1,  1, 1, 1,  1, 1,  1, 1, 1, 1,  1, 1, 1,  1, 1, 1, 1,  1 } },
+
+    //  a fifo, like the slots of a timer wheel or a work queue:
+    //  mostly appending, peeking at and removing the first element,
+    //  with some cancellations by position
+    //
+    { "queue",   { 0, 20, 0, 0,  0, 0, 0,  10, 2, 2,  2, 0,  16, 0, 3, 0,  0, 0, 0,  1, 1, 0, 0,  4 } },
+
+    //  an editor like list: inserting and deleting around positions,
+    //  walking and overwriting, from time to time a bulk operation
+    //
+    { "edit",    { 2, 4, 8, 8,  1, 1, 6,  1, 1, 6,  8, 8,  1, 1, 8, 0,  1, 1, 1,  1, 1, 1, 2,  1 } }
+};
+
+
+//  draws an operation from a mix
+//
+static unsigned char DrawOpcode(const DL_MIX& mix)
+{
+    unsigned int nTotal = 0;
+
+    for (int nOp = 0; nOp < DL_OP_COUNT; nOp++)
+    {
+        nTotal += mix.anWeights[nOp];
+    }
+
+    unsigned int nDraw = static_cast<unsigned int>(rand()) % nTotal;
+
+    for (int nOp = 0; nOp < DL_OP_COUNT; nOp++)
+    {
+        if (nDraw < mix.anWeights[nOp])
+        {
+            return static_cast<unsigned char>(nOp);
+        }
+
+        nDraw -= mix.anWeights[nOp];
+    }
+
+    return 0;
+}
+
+
+//=============================================================================
+//  driver
+//-----------------------------------------------------------------------------
+
+//  prints a failed operation
+//
+static void Report(const CdlListChecker& checker, const DL_TRACEOP& op, unsigned long nSeed)
+{
+    fprintf(stderr, "seed %lu, %s (%s %lu %lu %ld)\n", nSeed, checker.GetError(),
+            g_aszTraceNames[op.nOpcode], op.nList, op.nHandle, op.nValue);
+}
+
+
+//  checks a recorded trace against the model
+//
+static int Verify(const char* pszFile)
+{
+    std::vector<DL_TRACEOP> ops;
+    unsigned long           nLine = 0L;
+
+    if (false == ReadTrace(pszFile, ops, &nLine))
+    {
+        fprintf(stderr, "%s: not a valid trace (line %lu)\n", pszFile, nLine);
+        return 1;
+    }
+
+    CdlListChecker checker;
+
+    for (size_t nOp = 0; nOp < ops.size(); nOp++)
+    {
+        if (false == checker.Apply(ops[nOp]))
+        {
+            Report(checker, ops[nOp], 0L);
+            return 1;
+        }
+    }
+
+    printf("%s: %lu operations verified\n", pszFile, static_cast<unsigned long>(ops.size()));
+
+    return 0;
+}
+
+
+int main(int argc, char* argv[])
+{
+    unsigned long nSeed     = 1L;
+    unsigned long nRuns     = 200L;
+    unsigned long nOps      = 2000L;
+    const DL_MIX* pMix      = &g_aMixes[0];
+    const char*   pszRecord = 0;
+
+    for (int nArg = 1; nArg + 1 < argc; nArg += 2)
+    {
+        const char* pszValue = argv[nArg + 1];
+
+        if      (0 == strcmp(argv[nArg], "-seed"))   nSeed     = strtoul(pszValue, 0, 10);
+        else if (0 == strcmp(argv[nArg], "-runs"))   nRuns     = strtoul(pszValue, 0, 10);
+        else if (0 == strcmp(argv[nArg], "-ops"))    nOps      = strtoul(pszValue, 0, 10);
+        else if (0 == strcmp(argv[nArg], "-record")) pszRecord = pszValue;
+        else if (0 == strcmp(argv[nArg], "-verify")) return Verify(pszValue);
+
+        else if (0 == strcmp(argv[nArg], "-mix"))
+        {
+            pMix = 0;
+
+            for (size_t nMix = 0; nMix < sizeof(g_aMixes) / sizeof(g_aMixes[0]); nMix++)
+            {
+                if (0 == strcmp(pszValue, g_aMixes[nMix].pszName))
+                {
+                    pMix = &g_aMixes[nMix];
+                }
+            }
+
+            if (0 == pMix)
+            {
+                fprintf(stderr, "unknown mix '%s'\n", pszValue);
+                return 1;
+            }
+        }
+
+        else
+        {
+            fprintf(stderr, "unknown option '%s'\n", argv[nArg]);
+            return 1;
+        }
+    }
+
+    FILE* pRecord = 0;
+
+    if (0 != pszRecord)
+    {
+        if ( (0 == (pRecord = fopen(pszRecord, "w"))) || (false == WriteTraceHeader(pRecord)) )
+        {
+            fprintf(stderr, "can not write '%s'\n", pszRecord);
+            return 1;
+        }
+
+        fprintf(pRecord, "# dlListRandom -seed %lu -ops %lu -mix %s\n", nSeed, nOps, pMix->pszName);
+    }
+
+    for (unsigned long nRun = 0; nRun < nRuns; nRun++, nSeed++)
+    {
+        CdlListChecker checker;
+        DL_TRACEOP     op;
+        unsigned char  abBytes[DL_CHECKER_OPSIZE];
+
+        srand(static_cast<unsigned int>(nSeed));
+
+        for (unsigned long nOp = 0; nOp < nOps; nOp++)
+        {
+            abBytes[0] = DrawOpcode(*pMix);
+            abBytes[1] = static_cast<unsigned char>(rand());
+            abBytes[2] = static_cast<unsigned char>(rand());
+
+            checker.Decode(abBytes, op);
+
+            if (false == checker.Apply(op))
+            {
+                Report(checker, op, nSeed);
+                return 1;
+            }
+
+            if ( (0 != pRecord) && (0L == nRun) )
+            {
+                WriteTraceOp(pRecord, op);
+            }
+        }
+    }
+
+    if (0 != pRecord)
+    {
+        fclose(pRecord);
+    }
+
+    printf("%lu runs of %lu operations (%s) passed\n", nRuns, nOps, pMix->pszName);
+
+    return 0;
+}
+
+//  end of file
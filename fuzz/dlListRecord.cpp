@@ -0,0 +1,264 @@
+//=============================================================================
+//
+//  Copyright (c) 2004. Riccardo Riedl (www.riccardo-riedl.de)
+//
+//  Permission to use, copy, modify, distribute and sell this software and its
+//  documentation for any purpose is hereby granted without fee, provided that
+//  the above copyright notice appears in all copies and that both that
+//  copyright notice and this permission notice appear in supporting
+//  documentation.
+//
+//  There are no representations made about the suitability of this software
+//  for any purpose. It is provided "as is" without expressed or implied
+//  warranty.
+//
+//=============================================================================
+
+
+//=============================================================================
+//  dlListRecord
+//
+//  description:    records traces for dlListReplay with CdlRecordingList.
+//                  two small applications use the lists the way programs
+//                  typically do, and every call they make is written to
+//                  the trace:
+//
+//                  lru     a cache of 1024 entries in the order of their
+//                          use. a hit moves the entry to the end, a miss
+//                          adds one and evicts the first. the keys are
+//                          skewed, so that some of them are used often.
+//                          from time to time CompactStep() restores the
+//                          order of the nodes.
+//                  sched   a scheduler with a run queue and a wait queue.
+//                          the first task runs, then it either goes to the
+//                          end of the run queue, blocks, ends or starts a
+//                          new task. Partition() wakes up the waiting tasks
+//                          and a walk looks for the most urgent one.
+//
+//  usage:          dlListRecord lru|sched file [steps]
+//=============================================================================
+
+#include "dlTrace.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+
+
+//=============================================================================
+//  lru cache
+//-----------------------------------------------------------------------------
+
+#define DL_LRU_CAPACITY ( 1024 )
+#define DL_LRU_KEYS     ( 8192 )
+
+//  the trace holds the key of an entry
+//
+struct DL_KEYVALUE
+{
+    long operator()(long nKey) const { return nKey; }
+};
+
+typedef CdlRecordingList<long, DL_KEYVALUE> CdlLruList;
+typedef std::map<long, DL_POSITION>         DL_LRUMAP;
+
+//  keeps the positions in the map, when CompactStep() moves the nodes
+//
+static void LruRemap(DL_POSITION, DL_POSITION newPosition, void* pContext)
+{
+    DL_LRUMAP* pMap = static_cast<DL_LRUMAP*>(pContext);
+    (*pMap)[CdlLruList::ElementAt(newPosition)] = newPosition;
+}
+
+static void RunLru(CdlTraceRecorder& recorder, unsigned long nSteps)
+{
+    CdlLruList list(recorder);
+    DL_LRUMAP  positions;
+
+    for (unsigned long nStep = 0; nStep < nSteps; nStep++)
+    {
+        //  the product of two draws makes the small keys more frequent
+        //
+        const long nKey = (static_cast<long>(rand() % DL_LRU_KEYS) * (rand() % DL_LRU_KEYS)) / DL_LRU_KEYS;
+
+        DL_LRUMAP::iterator it = positions.find(nKey);
+        long                nValue = 0L;
+
+        if (positions.end() != it)
+        {
+            list.GetAt(nValue, it->second);
+            list.DeleteAt(it->second);
+            it->second = list.AddLast(nKey);
+        }
+
+        else
+        {
+            if (DL_LRU_CAPACITY <= positions.size())
+            {
+                list.GetFirst(nValue);
+                list.DeleteFirst();
+                positions.erase(nValue);
+            }
+
+            positions[nKey] = list.AddLast(nKey);
+        }
+
+        if (0L == nStep % 64L)
+        {
+            list.CompactStep(16L, LruRemap, &positions);
+        }
+    }
+}
+
+
+//=============================================================================
+//  scheduler
+//-----------------------------------------------------------------------------
+
+struct DL_TASK
+{
+    long nId;
+    long nWakeup;   //  the step at which a waiting task becomes ready
+    long nDeadline; //  the most urgent task has the smallest one
+};
+
+//  the trace holds the id of a task
+//
+struct DL_TASKVALUE
+{
+    long operator()(const DL_TASK& task) const { return task.nId; }
+};
+
+typedef CdlRecordingList<DL_TASK, DL_TASKVALUE> CdlTaskList;
+
+//  selects the waiting tasks, that are ready at a given step
+//
+struct DL_READY
+{
+    long nStep;
+
+    DL_READY(long nNow) : nStep(nNow) { ; }
+
+    bool operator()(const DL_TASK& task) const { return static_cast<bool>(task.nWakeup <= nStep); }
+};
+
+static void RunScheduler(CdlTraceRecorder& recorder, unsigned long nSteps)
+{
+    CdlTaskList run (recorder, 0L);
+    CdlTaskList wait(recorder, 1L);
+    long        nIds = 0L;
+
+    for (long nStep = 0L; nStep < static_cast<long>(nSteps); nStep++)
+    {
+        DL_TASK task;
+
+        //  keeps at least a few tasks around
+        //
+        if ( (run.GetCount() < 8L) || (0 == rand() % 16) )
+        {
+            task.nId       = ++nIds;
+            task.nWakeup   = 0L;
+            task.nDeadline = nStep + rand() % 1024;
+
+            run.AddLast(task);
+        }
+
+        if (0L == nStep % 8L)
+        {
+            wait.Partition(DL_READY(nStep), run);
+        }
+
+        //  from time to time the most urgent task runs first
+        //
+        if (0L == nStep % 32L)
+        {
+            DL_POSITION urgent = run.GetFirstPosition();
+            DL_TASK     other  = { 0L, 0L, 0L };
+
+            for (DL_POSITION position = urgent; 0 != position; position = run.GetNextPosition(position))
+            {
+                run.GetAt(other, position);
+
+                if (other.nDeadline < CdlTaskList::ElementAt(urgent).nDeadline)
+                {
+                    urgent = position;
+                }
+            }
+
+            run.GetAt(task, urgent);
+            run.DeleteAt(urgent);
+            run.AddFirst(task);
+        }
+
+        if (false == run.GetFirst(task))
+        {
+            continue;
+        }
+
+        const DL_POSITION first = run.GetFirstPosition();
+
+        switch (rand() % 8)
+        {
+            //  blocks until a later step
+            //
+            case 0:
+            case 1:
+                task.nWakeup = nStep + 1 + rand() % 64;
+                run.SetAt(task, first);
+                wait.MoveLast(run, first);
+                break;
+
+            //  ends
+            //
+            case 2:
+                run.DeleteFirst();
+                break;
+
+            //  its time slice is used up
+            //
+            default:
+                run.DeleteFirst();
+                run.AddLast(task);
+                break;
+        }
+    }
+}
+
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: dlListRecord lru|sched file [steps]\n");
+        return 1;
+    }
+
+    const unsigned long nSteps = (argc > 3) ? strtoul(argv[3], 0, 10) : 100000UL;
+    FILE*               pFile  = fopen(argv[2], "w");
+
+    if (0 == pFile)
+    {
+        fprintf(stderr, "can not write '%s'\n", argv[2]);
+        return 1;
+    }
+
+    srand(2004);
+
+    {
+        CdlTraceRecorder recorder(pFile);
+
+        if      (0 == strcmp(argv[1], "lru"))   RunLru      (recorder, nSteps);
+        else if (0 == strcmp(argv[1], "sched")) RunScheduler(recorder, nSteps);
+
+        else
+        {
+            fprintf(stderr, "unknown application '%s'\n", argv[1]);
+            fclose(pFile);
+            return 1;
+        }
+    }
+
+    return (0 == fclose(pFile)) ? 0 : 1;
+}
+
+//  end of file
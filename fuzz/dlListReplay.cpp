@@ -0,0 +1,150 @@
+//=============================================================================
+//
+//  Copyright (c) 2004. Riccardo Riedl (www.riccardo-riedl.de)
+//
+//  Permission to use, copy, modify, distribute and sell this software and its
+//  documentation for any purpose is hereby granted without fee, provided that
+//  the above copyright notice appears in all copies and that both that
+//  copyright notice and this permission notice appear in supporting
+//  documentation.
+//
+//  There are no representations made about the suitability of this software
+//  for any purpose. It is provided "as is" without expressed or implied
+//  warranty.
+//
+//=============================================================================
+
+
+//=============================================================================
+//  dlListReplay
+//
+//  description:    benchmark replaying recorded traces on CdlList. every
+//                  trace is checked against the model by CdlListChecker
+//                  first, so a change is only measured, when it is also
+//                  still correct. then it is replayed on plain CdlList
+//                  objects and the time per operation is reported.
+//                  the replay is repeated at least 'repeat' times and
+//                  until 'time' milliseconds have passed, so that short
+//                  traces give stable figures as well.
+//
+//  usage:          dlListReplay [-repeat n] [-time ms] trace...
+//=============================================================================
+
+#include "dlListChecker.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+//  keeps the results of the reading operations alive
+//
+static volatile long g_nSink = 0L;
+
+
+//  returns a monotonic time stamp in nanoseconds
+//
+static unsigned long long Now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return static_cast<unsigned long long>(now.tv_sec) * 1000000000ULL + now.tv_nsec;
+}
+
+
+//  verifies and replays one trace, returns false when it is invalid
+//
+static bool Replay(const char* pszFile, unsigned long nRepeat, unsigned long long nMinTime)
+{
+    std::vector<DL_TRACEOP> ops;
+    unsigned long           nLine = 0L;
+
+    if (false == ReadTrace(pszFile, ops, &nLine))
+    {
+        fprintf(stderr, "%s: not a valid trace (line %lu)\n", pszFile, nLine);
+        return false;
+    }
+
+    CdlListChecker checker;
+
+    for (size_t nOp = 0; nOp < ops.size(); nOp++)
+    {
+        if (false == checker.Apply(ops[nOp]))
+        {
+            fprintf(stderr, "%s: %s\n", pszFile, checker.GetError());
+            return false;
+        }
+    }
+
+    //  the lists are destroyed inside the measurement, as releasing
+    //  the remaining elements is part of the work of a real program
+    //
+    const unsigned long nHandles = CdlTraceReplay::CountHandles(ops);
+    unsigned long long  nBest    = 0ULL;
+    unsigned long long  nTotal   = 0ULL;
+    unsigned long       nRun     = 0L;
+
+    for (; (nRun < nRepeat) || (nTotal < nMinTime); nRun++)
+    {
+        unsigned long long nStart = Now();
+
+        {
+            CdlTraceReplay replay(nHandles);
+
+            for (size_t nOp = 0; nOp < ops.size(); nOp++)
+            {
+                replay.Apply(ops[nOp]);
+            }
+
+            g_nSink = g_nSink + replay.GetSum();
+        }
+
+        unsigned long long nTime = Now() - nStart;
+
+        nTotal += nTime;
+        nBest   = ( (0ULL == nBest) || (nTime < nBest) ) ? nTime : nBest;
+    }
+
+    const double dOps = (ops.empty()) ? 1.0 : static_cast<double>(ops.size());
+
+    printf("%-32s %10lu %8lu %10.2f %10.2f\n", pszFile, static_cast<unsigned long>(ops.size()),
+           nRun, nBest / dOps, nTotal / dOps / nRun);
+
+    return true;
+}
+
+
+int main(int argc, char* argv[])
+{
+    unsigned long nRepeat = 20L;
+    unsigned long nTime   = 1000L;
+    int           nArg    = 1;
+
+    for (; (nArg + 1 < argc) && ('-' == argv[nArg][0]); nArg += 2)
+    {
+        if      (0 == strcmp(argv[nArg], "-repeat")) nRepeat = strtoul(argv[nArg + 1], 0, 10);
+        else if (0 == strcmp(argv[nArg], "-time"))   nTime   = strtoul(argv[nArg + 1], 0, 10);
+        else                                         nRepeat = 0L;
+    }
+
+    if ( (nArg >= argc) || (0L == nRepeat) )
+    {
+        fprintf(stderr, "usage: dlListReplay [-repeat n] [-time ms] trace...\n");
+        return 1;
+    }
+
+    printf("%-32s %10s %8s %10s %10s\n", "trace", "ops", "replays", "best ns/op", "mean ns/op");
+
+    bool bOk = true;
+
+    for (; nArg < argc; nArg++)
+    {
+        bOk = Replay(argv[nArg], nRepeat, nTime * 1000000ULL) && bOk;
+    }
+
+    return (true == bOk) ? 0 : 1;
+}
+
+//  end of file
@@ -0,0 +1,819 @@
+//=============================================================================
+//
+//  Copyright (c) 2004. Riccardo Riedl (www.riccardo-riedl.de)
+//
+//  Permission to use, copy, modify, distribute and sell this software and its
+//  documentation for any purpose is hereby granted without fee, provided that
+//  the above copyright notice appears in all copies and that both that
+//  copyright notice and this permission notice appear in supporting
+//  documentation.
+//
+//  There are no representations made about the suitability of this software
+//  for any purpose. It is provided "as is" without expressed or implied
+//  warranty.
+//
+//=============================================================================
+
+
+//=============================================================================
+//  preprocessor directives
+//=============================================================================
+
+//  include this file only once
+//
+#ifndef DL_TRACE_INCLUDED__
+#define DL_TRACE_INCLUDED__
+
+#include "dlList.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+//  first line of a trace file
+//
+#define DL_TRACE_MAGIC  "dltrace 1"
+
+
+//=============================================================================
+//  trace format
+//
+//  description:    a trace is a text file starting with the line
+//                  DL_TRACE_MAGIC, followed by one operation per line:
+//
+//                      <methode> <list> <handle> <value>
+//
+//                  <methode> is the name of the CdlList methode (see
+//                  g_aszTraceNames), <list> is 0 or 1 for the two lists
+//                  a trace works on. every element added gets the next
+//                  handle, starting with 1. <handle> names the element
+//                  whose position is passed to the methode, 0 stands for
+//                  DL_NULL. <value> is the data of new or overwritten
+//                  elements, or the argument of RemoveIf(), Partition()
+//                  and CompactStep(). unused fields are 0. empty lines and
+//                  lines starting with '#' are ignored.
+//
+//                  the positions of Partition() and MoveLast() refer to
+//                  the other list: Partition() moves the matching elements
+//                  of <list> to the other one, MoveLast() moves <handle>
+//                  from the other list to the end of <list>, Splice() all
+//                  elements of the other list to the end of <list>.
+//=============================================================================
+
+//  the operations of a trace
+//
+enum DL_TRACEOPCODE
+{
+    DL_OP_ADDFIRST,
+    DL_OP_ADDLAST,
+    DL_OP_ADDAFTER,
+    DL_OP_ADDBEFORE,
+    DL_OP_SETFIRST,
+    DL_OP_SETLAST,
+    DL_OP_SETAT,
+    DL_OP_GETFIRST,
+    DL_OP_GETLAST,
+    DL_OP_GETAT,
+    DL_OP_GETNEXT,
+    DL_OP_GETPREVIOUS,
+    DL_OP_DELETEFIRST,
+    DL_OP_DELETELAST,
+    DL_OP_DELETEAT,
+    DL_OP_DELETEALL,
+    DL_OP_REMOVEIF,
+    DL_OP_PARTITION,
+    DL_OP_UNIQUE,
+    DL_OP_SPLICE,
+    DL_OP_MOVELAST,
+    DL_OP_COMPACT,
+    DL_OP_COMPACTSTEP,
+    DL_OP_GETCOUNT,
+
+    DL_OP_COUNT                 //  number of operations
+};
+
+//  the names of the operations in a trace, in the order of DL_TRACEOPCODE
+//
+static const char* const g_aszTraceNames[DL_OP_COUNT] =
+{
+    "AddFirst",    "AddLast",     "AddAfter",        "AddBefore",
+    "SetFirst",    "SetLast",     "SetAt",
+    "GetFirst",    "GetLast",     "GetAt",
+    "GetNextPosition",            "GetPreviousPosition",
+    "DeleteFirst", "DeleteLast",  "DeleteAt",        "DeleteAll",
+    "RemoveIf",    "Partition",   "Unique",
+    "Splice",      "MoveLast",    "Compact",         "CompactStep",
+    "GetCount"
+};
+
+
+//  one operation of a trace
+//
+struct DL_TRACEOP
+{
+    unsigned long nOpcode;      //  one of DL_TRACEOPCODE
+    unsigned long nList;        //  0 or 1
+    unsigned long nHandle;      //  element passed by position, 0 for DL_NULL
+    long          nValue;       //  data or argument
+};
+
+
+//  the element type of the lists. the handle is stored along with the
+//  data, so that a new position reported by Compact() can be assigned
+//  to its element without a search.
+//
+struct DL_TRACEITEM
+{
+    long          nValue;
+    unsigned long nHandle;
+};
+
+typedef CdlList<DL_TRACEITEM> CdlTraceList;
+
+
+//  the predicates of RemoveIf() and Partition() select the elements
+//  by the low bits of their value, Unique() compares the values
+//
+struct DL_TRACEMATCH
+{
+    long nArgument;
+
+    DL_TRACEMATCH(long nArg) : nArgument(nArg & 7) { ; }
+
+    bool operator()(const DL_TRACEITEM& item) const
+    {
+        return static_cast<bool>( (item.nValue & 7) == nArgument );
+    }
+};
+
+struct DL_TRACEEQUAL
+{
+    bool operator()(const DL_TRACEITEM& first, const DL_TRACEITEM& second) const
+    {
+        return static_cast<bool>( first.nValue == second.nValue );
+    }
+};
+
+
+//=============================================================================
+//  reading and writing traces
+//-----------------------------------------------------------------------------
+
+//  writes the header of a trace
+//
+inline bool WriteTraceHeader(FILE* pFile)
+{
+    return static_cast<bool>( 0 <= fprintf(pFile, "%s\n", DL_TRACE_MAGIC) );
+}
+
+
+//  writes one operation of a trace
+//
+inline bool WriteTraceOp(FILE* pFile, const DL_TRACEOP& op)
+{
+    return static_cast<bool>( 0 <= fprintf(pFile, "%s %lu %lu %ld\n",
+                                           g_aszTraceNames[op.nOpcode], op.nList, op.nHandle, op.nValue) );
+}
+
+
+//  reads a whole trace. returns false when the file can not be
+//  opened or is not a trace, 'pnLine' receives the bad line then.
+//
+inline bool ReadTrace(const char* pszFile, std::vector<DL_TRACEOP>& rOps, unsigned long* pnLine = 0)
+{
+    FILE* pFile = fopen(pszFile, "r");
+
+    if (0 == pFile)
+    {
+        return false;
+    }
+
+    char          szLine[256];
+    unsigned long nLine = 0L;
+    bool          bOk   = false;
+
+    rOps.clear();
+
+    while (0 != fgets(szLine, sizeof(szLine), pFile))
+    {
+        nLine++;
+
+        //  the header has to be the first line
+        //
+        if (1L == nLine)
+        {
+            if (0 != strncmp(szLine, DL_TRACE_MAGIC, strlen(DL_TRACE_MAGIC)))
+            {
+                break;
+            }
+
+            bOk = true;
+            continue;
+        }
+
+        char        szName[64];
+        DL_TRACEOP  op;
+
+        if ( ('#' == szLine[0]) || (1 > sscanf(szLine, "%63s", szName)) )
+        {
+            continue;
+        }
+
+        if (4 != sscanf(szLine, "%63s %lu %lu %ld", szName, &op.nList, &op.nHandle, &op.nValue))
+        {
+            bOk = false;
+            break;
+        }
+
+        for (op.nOpcode = 0; op.nOpcode < DL_OP_COUNT; op.nOpcode++)
+        {
+            if (0 == strcmp(szName, g_aszTraceNames[op.nOpcode]))
+            {
+                break;
+            }
+        }
+
+        if ( (DL_OP_COUNT == op.nOpcode) || (op.nList > 1) )
+        {
+            bOk = false;
+            break;
+        }
+
+        rOps.push_back(op);
+    }
+
+    fclose(pFile);
+
+    if ( (false == bOk) && (0 != pnLine) )
+    {
+        *pnLine = nLine;
+    }
+
+    return bOk;
+}
+
+
+//=============================================================================
+//  CdlTraceReplay class
+//
+//  description:    replays a trace on two CdlList objects without checking
+//                  the results, as fast as possible. the positions of the
+//                  elements are kept in a table indexed by their handles.
+//=============================================================================
+
+class CdlTraceReplay
+{
+private:
+
+    CdlTraceList             m_lists[2];
+    std::vector<DL_POSITION> m_positions;   //  position of every handle
+    unsigned long            m_nHandles;    //  the last handle given out
+    long                     m_nSum;        //  the data read by the Get methodes
+
+    //  keeps the position table up to date, when Compact() moves a node
+    //
+    static void Remap(DL_POSITION, DL_POSITION newPosition, void* pContext)
+    {
+        CdlTraceReplay* pReplay = static_cast<CdlTraceReplay*>(pContext);
+        pReplay->m_positions[CdlTraceList::ElementAt(newPosition).nHandle] = newPosition;
+    }
+
+    //  records the position of a new element
+    //
+    void Added(DL_POSITION position)
+    {
+        if (0 != position)
+        {
+            m_positions[++m_nHandles] = position;
+        }
+    }
+
+    //  reads the positions of all elements of a list again, after
+    //  Partition() has copied the nodes from a block of Compact()
+    //
+    void Rescan(CdlTraceList& list)
+    {
+        for (DL_POSITION position = list.GetFirstPosition(); 0 != position; position = list.GetNextPosition(position))
+        {
+            m_positions[CdlTraceList::ElementAt(position).nHandle] = position;
+        }
+    }
+
+public:
+
+    //  'nHandles' is the number of handles in the trace, see CountHandles()
+    //
+    CdlTraceReplay(unsigned long nHandles)
+        : m_positions (nHandles + 1, DL_POSITION(0))
+        , m_nHandles  (0L)
+        , m_nSum      (0L)
+    {
+        ;   //  intentionally left blank
+    }
+
+    long GetSum(void) const { return m_nSum; }
+
+    //  the number of elements added by a trace
+    //
+    static unsigned long CountHandles(const std::vector<DL_TRACEOP>& ops)
+    {
+        unsigned long nHandles = 0L;
+
+        for (size_t nOp = 0; nOp < ops.size(); nOp++)
+        {
+            if (ops[nOp].nOpcode <= DL_OP_ADDBEFORE)
+            {
+                nHandles++;
+            }
+        }
+
+        return nHandles;
+    }
+
+    //  replays one operation
+    //
+    void Apply(const DL_TRACEOP& op)
+    {
+        CdlTraceList& list  = m_lists[op.nList];
+        CdlTraceList& other = m_lists[op.nList ^ 1];
+        DL_POSITION   position = m_positions[op.nHandle];
+        DL_TRACEITEM  item;
+
+        item.nValue  = op.nValue;
+        item.nHandle = m_nHandles + 1;
+
+        switch (op.nOpcode)
+        {
+            case DL_OP_ADDFIRST:    Added(list.AddFirst (item));           break;
+            case DL_OP_ADDLAST:     Added(list.AddLast  (item));           break;
+            case DL_OP_ADDAFTER:    Added(list.AddAfter (item, position)); break;
+            case DL_OP_ADDBEFORE:   Added(list.AddBefore(item, position)); break;
+
+            //  the overwritten elements keep their handles
+            //
+            case DL_OP_SETFIRST:
+                if (false == list.IsEmpty())
+                {
+                    item.nHandle = CdlTraceList::ElementAt(list.GetFirstPosition()).nHandle;
+                    list.SetFirst(item);
+                }
+                break;
+
+            case DL_OP_SETLAST:
+                if (false == list.IsEmpty())
+                {
+                    item.nHandle = CdlTraceList::ElementAt(list.GetLastPosition()).nHandle;
+                    list.SetLast(item);
+                }
+                break;
+
+            case DL_OP_SETAT:
+                item.nHandle = op.nHandle;
+                list.SetAt(item, position);
+                break;
+
+            case DL_OP_GETFIRST:    list.GetFirst(item);           m_nSum += item.nValue; break;
+            case DL_OP_GETLAST:     list.GetLast (item);           m_nSum += item.nValue; break;
+            case DL_OP_GETAT:       list.GetAt   (item, position); m_nSum += item.nValue; break;
+
+            case DL_OP_GETNEXT:     m_nSum += (0 != list.GetNextPosition    (position)); break;
+            case DL_OP_GETPREVIOUS: m_nSum += (0 != list.GetPreviousPosition(position)); break;
+
+            case DL_OP_DELETEFIRST: list.DeleteFirst();        break;
+            case DL_OP_DELETELAST:  list.DeleteLast();         break;
+            case DL_OP_DELETEAT:    list.DeleteAt(position);   break;
+            case DL_OP_DELETEALL:   list.DeleteAll();          break;
+
+            case DL_OP_REMOVEIF:    list.RemoveIf(DL_TRACEMATCH(op.nValue)); break;
+            case DL_OP_UNIQUE:      list.Unique(DL_TRACEEQUAL());            break;
+            case DL_OP_SPLICE:      list.Splice(other);                      break;
+
+            case DL_OP_PARTITION:
+                if (0L != list.Partition(DL_TRACEMATCH(op.nValue), other))
+                {
+                    Rescan(other);
+                }
+                break;
+
+            case DL_OP_MOVELAST:
+                position = list.MoveLast(other, position);
+
+                if (0 != position)
+                {
+                    m_positions[op.nHandle] = position;
+                }
+                break;
+
+            case DL_OP_COMPACT:     list.Compact(Remap, this);                                         break;
+            case DL_OP_COMPACTSTEP: list.CompactStep(static_cast<unsigned long>(op.nValue), Remap, this); break;
+            case DL_OP_GETCOUNT:    m_nSum += static_cast<long>(list.GetCount());                      break;
+        }
+    }
+};
+
+//=============================================================================
+//  CdlTraceRecorder class
+//
+//  description:    writes the operations of one or two CdlRecordingList
+//                  objects to a trace and gives out the handles of the
+//                  added elements. the lists of one recorder must be
+//                  created with the list numbers 0 and 1.
+//=============================================================================
+
+class CdlTraceRecorder
+{
+private:
+
+    FILE*         m_pFile;
+    unsigned long m_nHandles;   //  the last handle given out
+
+public:
+
+    //  writes the header of the trace to 'pFile'. the file stays
+    //  open and is written to until the recorder is destroyed.
+    //
+    CdlTraceRecorder(FILE* pFile)
+        : m_pFile    (pFile)
+        , m_nHandles (0L)
+    {
+        WriteTraceHeader(m_pFile);
+    }
+
+    //  the handle the next added element gets
+    //
+    unsigned long GetNextHandle(void) const { return m_nHandles + 1; }
+
+    //  records one operation. the handle of an Add methode is used up,
+    //  when the element could be added.
+    //
+    void Record(DL_TRACEOPCODE nOpcode, unsigned long nList, unsigned long nHandle, long nValue)
+    {
+        DL_TRACEOP op;
+
+        op.nOpcode = nOpcode;
+        op.nList   = nList;
+        op.nHandle = nHandle;
+        op.nValue  = nValue;
+
+        WriteTraceOp(m_pFile, op);
+    }
+
+    void Added(DL_POSITION position)
+    {
+        if (0 != position)
+        {
+            m_nHandles++;
+        }
+    }
+};
+
+
+//=============================================================================
+//  CdlRecordingList template class
+//
+//  description:    a CdlList with the same methodes, which records every
+//                  call as a trace operation, so that the operation mix of
+//                  a real program can be replayed by dlListReplay. replace
+//                  CdlList<DATATYPE> by CdlRecordingList<DATATYPE> and pass
+//                  a CdlTraceRecorder to the constructor. the handle of
+//                  every element is stored along with it, so it is found
+//                  from a position without a search.
+//
+//                  'VALUE' turns an element into the <value> of the trace,
+//                  by default it is 0. the predicates of RemoveIf(),
+//                  Partition() and Unique() can not be written to a trace,
+//                  so those calls are recorded as the DeleteAt() and
+//                  MoveLast() operations they result in. methodes without
+//                  a trace operation, like GetFirstPosition(), are not
+//                  recorded.
+//=============================================================================
+
+//  the default 'VALUE' of CdlRecordingList
+//
+struct DL_TRACENOVALUE
+{
+    template <class DATATYPE> long operator()(const DATATYPE&) const { return 0L; }
+};
+
+
+template <class DATATYPE, class VALUE = DL_TRACENOVALUE> class CdlRecordingList
+{
+private:
+
+    //  the element type of the list below
+    //
+    struct DL_RECORDITEM
+    {
+        DATATYPE      data;
+        unsigned long nHandle;
+    };
+
+    typedef CdlList<DL_RECORDITEM> CdlItemList;
+
+    //  calls the predicates of the caller with the data and collects
+    //  the handles of the elements they select
+    //
+    template <class PREDICATE> struct DL_RECORDPRED
+    {
+        PREDICATE&                  pred;
+        std::vector<unsigned long>& handles;
+
+        DL_RECORDPRED(PREDICATE& p, std::vector<unsigned long>& h) : pred(p), handles(h) { ; }
+
+        bool operator()(const DL_RECORDITEM& item) const
+        {
+            const bool bSelected = static_cast<bool>( pred(item.data) );
+
+            if (true == bSelected)
+            {
+                handles.push_back(item.nHandle);
+            }
+
+            return bSelected;
+        }
+    };
+
+    //  Unique() calls eq() with the kept and the following element
+    //
+    template <class EQUAL> struct DL_RECORDEQUAL
+    {
+        EQUAL&                      eq;
+        std::vector<unsigned long>& handles;
+
+        DL_RECORDEQUAL(EQUAL& e, std::vector<unsigned long>& h) : eq(e), handles(h) { ; }
+
+        bool operator()(const DL_RECORDITEM& kept, const DL_RECORDITEM& item) const
+        {
+            const bool bEqual = static_cast<bool>( eq(kept.data, item.data) );
+
+            if (true == bEqual)
+            {
+                handles.push_back(item.nHandle);
+            }
+
+            return bEqual;
+        }
+    };
+
+    CdlItemList       m_list;
+    CdlTraceRecorder& m_recorder;
+    unsigned long     m_nList;      //  0 or 1
+    VALUE             m_value;
+
+    //  returns the handle of the element at 'position', 0 for DL_NULL
+    //
+    static unsigned long HandleAt(const DL_POSITION position)
+    {
+        return (0 == position) ? 0L : CdlItemList::ElementAt(position).nHandle;
+    }
+
+    //  records an operation on this list
+    //
+    void Record(DL_TRACEOPCODE nOpcode, unsigned long nHandle = 0L, long nValue = 0L)
+    {
+        m_recorder.Record(nOpcode, m_nList, nHandle, nValue);
+    }
+
+    //  records the elements removed from or moved out of this list
+    //  by a predicate as DeleteAt() or as MoveLast() of 'pOther'
+    //
+    void RecordSelected(const std::vector<unsigned long>& handles, const CdlRecordingList* pOther = 0)
+    {
+        for (size_t nIndex = 0; nIndex < handles.size(); nIndex++)
+        {
+            (0 == pOther)
+                ? Record(DL_OP_DELETEAT, handles[nIndex])
+                : m_recorder.Record(DL_OP_MOVELAST, pOther->m_nList, handles[nIndex], 0L);
+        }
+    }
+
+    //  creates the element for an Add or Set methode
+    //
+    static DL_RECORDITEM Item(const DATATYPE& data, unsigned long nHandle)
+    {
+        DL_RECORDITEM item = { data, nHandle };
+        return item;
+    }
+
+    //  passes the data read by a Get methode to the caller
+    //
+    static bool Got(bool bResult, const DL_RECORDITEM& item, DATATYPE& rValue)
+    {
+        if (true == bResult)
+        {
+            rValue = item.data;
+        }
+
+        return bResult;
+    }
+
+    DL_POSITION Added(DL_TRACEOPCODE nOpcode, const DATATYPE& data, DL_POSITION position, DL_POSITION added)
+    {
+        Record(nOpcode, HandleAt(position), m_value(data));
+        m_recorder.Added(added);
+
+        return added;
+    }
+
+public:
+
+    CdlRecordingList(CdlTraceRecorder& recorder, unsigned long nList = 0L, const VALUE& value = VALUE())
+        : m_recorder (recorder)
+        , m_nList    (nList)
+        , m_value    (value)
+    {
+        ;   //  intentionally left blank
+    }
+
+    //  the methodes of CdlList
+    //
+    DL_POSITION AddFirst(const DATATYPE& data)
+    {
+        return Added(DL_OP_ADDFIRST, data, 0, m_list.AddFirst(Item(data, m_recorder.GetNextHandle())));
+    }
+
+    DL_POSITION AddLast(const DATATYPE& data)
+    {
+        return Added(DL_OP_ADDLAST, data, 0, m_list.AddLast(Item(data, m_recorder.GetNextHandle())));
+    }
+
+    DL_POSITION AddAfter(const DATATYPE& data, const DL_POSITION position)
+    {
+        return Added(DL_OP_ADDAFTER, data, position, m_list.AddAfter(Item(data, m_recorder.GetNextHandle()), position));
+    }
+
+    DL_POSITION AddBefore(const DATATYPE& data, const DL_POSITION position)
+    {
+        return Added(DL_OP_ADDBEFORE, data, position, m_list.AddBefore(Item(data, m_recorder.GetNextHandle()), position));
+    }
+
+    DL_POSITION GetFirstPosition(void) { return m_list.GetFirstPosition(); }
+    DL_POSITION GetLastPosition (void) { return m_list.GetLastPosition();  }
+
+    DL_POSITION GetNextPosition(const DL_POSITION position)
+    {
+        Record(DL_OP_GETNEXT, HandleAt(position));
+        return m_list.GetNextPosition(position);
+    }
+
+    DL_POSITION GetPreviousPosition(const DL_POSITION position)
+    {
+        Record(DL_OP_GETPREVIOUS, HandleAt(position));
+        return m_list.GetPreviousPosition(position);
+    }
+
+    bool SetFirst(const DATATYPE& data)
+    {
+        Record(DL_OP_SETFIRST, 0L, m_value(data));
+        return m_list.SetFirst(Item(data, HandleAt(m_list.GetFirstPosition())));
+    }
+
+    bool SetLast(const DATATYPE& data)
+    {
+        Record(DL_OP_SETLAST, 0L, m_value(data));
+        return m_list.SetLast(Item(data, HandleAt(m_list.GetLastPosition())));
+    }
+
+    bool SetAt(const DATATYPE& data, const DL_POSITION position)
+    {
+        Record(DL_OP_SETAT, HandleAt(position), m_value(data));
+        return m_list.SetAt(Item(data, HandleAt(position)), position);
+    }
+
+    bool GetFirst(DATATYPE& rValue)
+    {
+        DL_RECORDITEM item;
+
+        Record(DL_OP_GETFIRST);
+        return Got(m_list.GetFirst(item), item, rValue);
+    }
+
+    bool GetLast(DATATYPE& rValue)
+    {
+        DL_RECORDITEM item;
+
+        Record(DL_OP_GETLAST);
+        return Got(m_list.GetLast(item), item, rValue);
+    }
+
+    bool GetAt(DATATYPE& rValue, const DL_POSITION position)
+    {
+        DL_RECORDITEM item;
+
+        Record(DL_OP_GETAT, HandleAt(position));
+        return Got(m_list.GetAt(item, position), item, rValue);
+    }
+
+    static DATATYPE& ElementAt(const DL_POSITION position)
+    {
+        return CdlItemList::ElementAt(position).data;
+    }
+
+    bool DeleteFirst(void)                      { Record(DL_OP_DELETEFIRST);                  return m_list.DeleteFirst();        }
+    bool DeleteLast (void)                      { Record(DL_OP_DELETELAST);                   return m_list.DeleteLast();         }
+    void DeleteAll  (void)                      { Record(DL_OP_DELETEALL);                    m_list.DeleteAll();                 }
+    bool DeleteAt   (const DL_POSITION position) { Record(DL_OP_DELETEAT, HandleAt(position)); return m_list.DeleteAt(position);   }
+
+    template <class PREDICATE> unsigned long RemoveIf(PREDICATE pred)
+    {
+        std::vector<unsigned long> handles;
+        unsigned long              nRemoved = 0L;
+
+        try
+        {
+            nRemoved = m_list.RemoveIf(DL_RECORDPRED<PREDICATE>(pred, handles));
+        }
+
+        catch (...)
+        {
+            RecordSelected(handles);
+            throw;
+        }
+
+        RecordSelected(handles);
+        return nRemoved;
+    }
+
+    template <class PREDICATE> unsigned long Partition(PREDICATE pred, CdlRecordingList& rOther)
+    {
+        std::vector<unsigned long> handles;
+        unsigned long              nMoved = 0L;
+
+        try
+        {
+            nMoved = m_list.Partition(DL_RECORDPRED<PREDICATE>(pred, handles), rOther.m_list);
+        }
+
+        catch (...)
+        {
+            RecordSelected(handles, &rOther);
+            throw;
+        }
+
+        RecordSelected(handles, &rOther);
+        return nMoved;
+    }
+
+    template <class EQUAL> unsigned long Unique(EQUAL eq)
+    {
+        std::vector<unsigned long> handles;
+        unsigned long              nRemoved = 0L;
+
+        try
+        {
+            nRemoved = m_list.Unique(DL_RECORDEQUAL<EQUAL>(eq, handles));
+        }
+
+        catch (...)
+        {
+            RecordSelected(handles);
+            throw;
+        }
+
+        RecordSelected(handles);
+        return nRemoved;
+    }
+
+    void Splice(CdlRecordingList& rOther)
+    {
+        Record(DL_OP_SPLICE);
+        m_list.Splice(rOther.m_list);
+    }
+
+    DL_POSITION MoveLast(CdlRecordingList& rFrom, const DL_POSITION position)
+    {
+        Record(DL_OP_MOVELAST, HandleAt(position));
+        return m_list.MoveLast(rFrom.m_list, position);
+    }
+
+    unsigned long GetCount(void)
+    {
+        Record(DL_OP_GETCOUNT);
+        return m_list.GetCount();
+    }
+
+    bool IsEmpty(void)
+    {
+        Record(DL_OP_GETCOUNT);
+        return m_list.IsEmpty();
+    }
+
+    bool IsValidPosition(const DL_POSITION position) { return m_list.IsValidPosition(position); }
+    bool IsConsistent   (void) const                 { return m_list.IsConsistent(); }
+
+    bool Compact(DL_REMAP pfnRemap = 0, void* pContext = 0)
+    {
+        Record(DL_OP_COMPACT);
+        return m_list.Compact(pfnRemap, pContext);
+    }
+
+    bool CompactStep(unsigned long nMaxNodes, DL_REMAP pfnRemap = 0, void* pContext = 0)
+    {
+        Record(DL_OP_COMPACTSTEP, 0L, static_cast<long>(nMaxNodes));
+        return m_list.CompactStep(nMaxNodes, pfnRemap, pContext);
+    }
+};
+
+#endif  //  DL_TRACE_INCLUDED__
+
+//  end of file
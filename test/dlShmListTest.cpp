@@ -0,0 +1,467 @@
+//=============================================================================
+//
+//  Copyright (c) 2004. Riccardo Riedl (www.riccardo-riedl.de)
+//
+//  Permission to use, copy, modify, distribute and sell this software and its
+//  documentation for any purpose is hereby granted without fee, provided that
+//  the above copyright notice appears in all copies and that both that
+//  copyright notice and this permission notice appear in supporting
+//  documentation.
+//
+//  There are no representations made about the suitability of this software
+//  for any purpose. It is provided "as is" without expressed or implied
+//  warranty.
+//
+//=============================================================================
+
+
+//=============================================================================
+//  dlShmListTest
+//
+//  description:    test of CdlShmList with several processes. the child
+//                  processes are forked and report through their exit
+//                  code, so every test also runs the creating, attaching
+//                  and locking code in another process than the parent.
+//
+//  usage:          dlShmListTest
+//=============================================================================
+
+#include "dlShmList.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+
+//  reports a failed check and leaves the current test
+//
+#define DL_CHECK(expr)                                                  \
+    if (!(expr))                                                        \
+    {                                                                   \
+        fprintf(stderr, "line %d: check failed: %s\n", __LINE__, #expr); \
+        return false;                                                   \
+    }
+
+//  number of elements every process adds in the concurrent test
+//
+#define DL_TEST_COUNT ( 20000L )
+
+
+//  name of the segment, unique for every run of the test
+//
+static char g_szName[64];
+
+
+//  a type with the same size as long, which Attach() must tell apart
+//
+struct DL_OTHER
+{
+    long nValue;
+};
+
+
+//  copies the elements from the first to the last one into 'values'
+//
+template <class DATATYPE>
+static void Collect(CdlShmList<DATATYPE>& list, std::vector<DATATYPE>& values)
+{
+    values.clear();
+
+    list.Lock();
+
+    for (DL_POSITION pos = list.GetFirstPosition(); 0 != pos; pos = list.GetNextPosition(pos))
+    {
+        DATATYPE value;
+
+        list.GetAt(value, pos);
+        values.push_back(value);
+    }
+
+    list.Unlock();
+}
+
+
+//  forks a child, which runs 'pfnChild' and exits with 0 when it returned
+//  true. returns true when the child exited that way.
+//
+static bool RunChild(bool (*pfnChild)(void))
+{
+    fflush(0);
+
+    pid_t nChild = fork();
+
+    if (0 == nChild)
+    {
+        _exit( (true == pfnChild()) ? 0 : 1 );
+    }
+
+    int nStatus = 0;
+
+    return (0 < nChild)
+        && (nChild == waitpid(nChild, &nStatus, 0))
+        && WIFEXITED(nStatus)
+        && (0 == WEXITSTATUS(nStatus));
+}
+
+
+//=============================================================================
+//  positions of deleted nodes
+//-----------------------------------------------------------------------------
+
+//  a position, whose node has been deleted, must be rejected by every
+//  methode and must leave the list as it was
+//
+static bool TestStalePosition(void)
+{
+    CdlShmList<long> list;
+    DL_CHECK(list.Create(g_szName, 8L));
+
+    list.AddLast(1L);
+    DL_POSITION pos = list.AddLast(2L);
+    list.AddLast(3L);
+
+    DL_CHECK(true  == list.DeleteAt(pos));
+    DL_CHECK(false == list.IsValidPosition(pos));
+    DL_CHECK(false == list.DeleteAt(pos));
+    DL_CHECK(0 == list.AddAfter(4L, pos));
+    DL_CHECK(0 == list.AddBefore(4L, pos));
+    DL_CHECK(0 == list.GetNextPosition(pos));
+    DL_CHECK(0 == list.GetPreviousPosition(pos));
+    DL_CHECK(false == list.SetAt(4L, pos));
+
+    long nValue = 0L;
+    DL_CHECK(false == list.GetAt(nValue, pos));
+
+    std::vector<long> values;
+    Collect(list, values);
+
+    DL_CHECK(2L == list.GetCount());
+    DL_CHECK( (2 == values.size()) && (1L == values[0]) && (3L == values[1]) );
+
+    //  the deleted node is reused by the next Add methode
+    //
+    DL_CHECK(pos == list.AddFirst(5L));
+    DL_CHECK(true == list.IsValidPosition(pos));
+    DL_CHECK( (true == list.GetAt(nValue, pos)) && (5L == nValue) );
+
+    list.Detach();
+
+    return CdlShmList<long>::Unlink(g_szName);
+}
+
+
+//=============================================================================
+//  create and attach in different processes
+//-----------------------------------------------------------------------------
+
+static bool ChildCreate(void)
+{
+    CdlShmList<long> list;
+
+    if (false == list.Create(g_szName, 16L))
+    {
+        return false;
+    }
+
+    for (long nValue = 0L; nValue < 10L; nValue++)
+    {
+        list.AddLast(nValue);
+    }
+
+    //  the segment and its elements stay, when the process ends
+    //
+    return true;
+}
+
+static bool ChildAttach(void)
+{
+    CdlShmList<long> list;
+    std::vector<long> values;
+
+    if (false == list.Attach(g_szName))
+    {
+        return false;
+    }
+
+    Collect(list, values);
+
+    if ( (10 != values.size()) || (2L != list.GetAttached()) )
+    {
+        return false;
+    }
+
+    //  replaces the elements by their squares
+    //
+    list.DeleteAll();
+
+    for (size_t nValue = 0; nValue < values.size(); nValue++)
+    {
+        list.AddLast(values[nValue] * values[nValue]);
+    }
+
+    return true;
+}
+
+static bool TestCreateAttach(void)
+{
+    DL_CHECK(true == RunChild(ChildCreate));
+
+    CdlShmList<long> list;
+    DL_CHECK(true == list.Attach(g_szName));
+    DL_CHECK(16L == list.GetCapacity());
+    DL_CHECK(1L  == list.GetAttached());
+
+    std::vector<long> values;
+    Collect(list, values);
+
+    DL_CHECK(10 == values.size());
+
+    for (size_t nValue = 0; nValue < values.size(); nValue++)
+    {
+        DL_CHECK(static_cast<long>(nValue) == values[nValue]);
+    }
+
+    DL_CHECK(true == RunChild(ChildAttach));
+    DL_CHECK(1L   == list.GetAttached());
+
+    Collect(list, values);
+
+    DL_CHECK(10 == values.size());
+
+    for (size_t nValue = 0; nValue < values.size(); nValue++)
+    {
+        DL_CHECK(static_cast<long>(nValue * nValue) == values[nValue]);
+    }
+
+    list.Detach();
+
+    return CdlShmList<long>::Unlink(g_szName);
+}
+
+
+//=============================================================================
+//  both processes editing the list at the same time
+//-----------------------------------------------------------------------------
+
+//  adds the odd or the even numbers below 2 * DL_TEST_COUNT, deleting
+//  every third element again, and inserting a negative one before it
+//
+static bool Edit(CdlShmList<long>& list, long nFirst)
+{
+    for (long nValue = nFirst; nValue < 2L * DL_TEST_COUNT; nValue += 2L)
+    {
+        DL_POSITION pos = list.AddLast(nValue);
+
+        if (0 == pos)
+        {
+            return false;
+        }
+
+        if (0L == (nValue / 2L) % 3L)
+        {
+            //  the other process can not delete this node, so both
+            //  calls must succeed on the position
+            //
+            if ( (0 == list.AddBefore(-nValue - 1L, pos))
+              || (false == list.DeleteAt(pos)) )
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool ChildEdit(void)
+{
+    CdlShmList<long> list;
+
+    return list.Attach(g_szName)
+        && Edit(list, 1L);
+}
+
+static bool TestConcurrent(void)
+{
+    CdlShmList<long> list;
+    DL_CHECK(list.Create(g_szName, 2L * DL_TEST_COUNT));
+
+    //  the child blocks in Attach() until the parent is ready as well,
+    //  so that both start editing at the same time
+    //
+    DL_CHECK(list.Lock());
+    fflush(0);
+
+    pid_t nChild = fork();
+
+    if (0 == nChild)
+    {
+        _exit( (true == ChildEdit()) ? 0 : 1 );
+    }
+
+    list.Unlock();
+    DL_CHECK(0 < nChild);
+
+    bool bEdit   = Edit(list, 0L);
+    int  nStatus = 0;
+
+    DL_CHECK(nChild == waitpid(nChild, &nStatus, 0));
+    DL_CHECK(WIFEXITED(nStatus) && (0 == WEXITSTATUS(nStatus)));
+    DL_CHECK(true == bEdit);
+
+    //  every value or its replacement is in the list once, and the
+    //  elements of each process are in the order they were added
+    //
+    std::vector<long> values;
+    Collect(list, values);
+
+    DL_CHECK(2L * DL_TEST_COUNT == list.GetCount());
+    DL_CHECK(2L * DL_TEST_COUNT == values.size());
+
+    std::vector<bool> seen(2L * DL_TEST_COUNT, false);
+    long              anLast[2] = { -1L, -1L };
+
+    for (size_t nIndex = 0; nIndex < values.size(); nIndex++)
+    {
+        const long nValue = (0L > values[nIndex]) ? -values[nIndex] - 1L : values[nIndex];
+
+        DL_CHECK( (0L <= nValue) && (nValue < 2L * DL_TEST_COUNT) && (false == seen[nValue]) );
+        DL_CHECK(anLast[nValue % 2L] < nValue);
+
+        seen[nValue]          = true;
+        anLast[nValue % 2L]   = nValue;
+    }
+
+    list.Detach();
+
+    return CdlShmList<long>::Unlink(g_szName);
+}
+
+
+//=============================================================================
+//  attaching with another DATATYPE
+//-----------------------------------------------------------------------------
+
+static bool ChildAttachOther(void)
+{
+    CdlShmList<DL_OTHER> other;
+    CdlShmList<int>      small;
+    CdlShmList<long>     list;
+
+    return (false == other.Attach(g_szName))
+        && (false == small.Attach(g_szName))
+        && (true  == other.Attach(g_szName, 42L))
+        && (false == list.Attach(g_szName));
+}
+
+static bool TestAttachOther(void)
+{
+    //  the id given to Create() is checked instead of the type name
+    //
+    CdlShmList<DL_OTHER> list;
+    DL_CHECK(list.Create(g_szName, 4L, 42L));
+
+    DL_CHECK(true == RunChild(ChildAttachOther));
+    DL_CHECK(1L   == list.GetAttached());
+
+    list.Detach();
+
+    return CdlShmList<long>::Unlink(g_szName);
+}
+
+
+//=============================================================================
+//  a process dying while it holds the mutex
+//-----------------------------------------------------------------------------
+
+static bool ChildDieLocked(void)
+{
+    CdlShmList<long> list;
+
+    if ( (false == list.Attach(g_szName)) || (false == list.Lock()) )
+    {
+        return false;
+    }
+
+    list.AddLast(3L);
+
+    //  ends without Unlock() and without the destructor, which would
+    //  unmap the segment and hide the mutex from the kernel
+    //
+    _exit(0);
+}
+
+static bool TestOwnerDied(void)
+{
+    CdlShmList<long> list;
+    DL_CHECK(list.Create(g_szName, 8L));
+
+    list.AddLast(1L);
+    list.AddLast(2L);
+
+    DL_CHECK(true == RunChild(ChildDieLocked));
+
+    //  the list refuses any access until Reset()
+    //
+    DL_CHECK(true    == list.IsDamaged());
+    DL_CHECK(false   == list.Lock());
+    DL_CHECK(0L      == list.GetCount());
+    DL_CHECK(0 == list.AddLast(4L));
+    DL_CHECK(0 == list.GetFirstPosition());
+    DL_CHECK(false   == list.DeleteFirst());
+
+    DL_CHECK(true    == list.Reset());
+    DL_CHECK(false   == list.IsDamaged());
+    DL_CHECK(true    == list.IsEmpty());
+
+    DL_CHECK(0 != list.AddLast(5L));
+    DL_CHECK(1L      == list.GetCount());
+
+    long nValue = 0L;
+    DL_CHECK( (true == list.GetFirst(nValue)) && (5L == nValue) );
+
+    list.Detach();
+
+    return CdlShmList<long>::Unlink(g_szName);
+}
+
+
+int main(void)
+{
+    snprintf(g_szName, sizeof(g_szName), "/dlShmListTest.%ld", static_cast<long>(getpid()));
+
+    struct
+    {
+        const char* pszName;
+        bool        (*pfnTest)(void);
+    }
+    aTests[] =
+    {
+        { "stale position",    TestStalePosition },
+        { "create and attach", TestCreateAttach  },
+        { "concurrent edit",   TestConcurrent    },
+        { "other DATATYPE",    TestAttachOther   },
+        { "owner died",        TestOwnerDied     }
+    };
+
+    bool bOk = true;
+
+    for (size_t nTest = 0; nTest < sizeof(aTests) / sizeof(aTests[0]); nTest++)
+    {
+        const bool bPassed = aTests[nTest].pfnTest();
+
+        printf("%-20s %s\n", aTests[nTest].pszName, (true == bPassed) ? "passed" : "FAILED");
+
+        //  a failed test might have left its segment behind
+        //
+        CdlShmList<long>::Unlink(g_szName);
+
+        bOk = bPassed && bOk;
+    }
+
+    return (true == bOk) ? 0 : 1;
+}
+
+//  end of file
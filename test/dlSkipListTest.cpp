@@ -0,0 +1,308 @@
+//=============================================================================
+//
+//  Copyright (c) 2004. Riccardo Riedl (www.riccardo-riedl.de)
+//
+//  Permission to use, copy, modify, distribute and sell this software and its
+//  documentation for any purpose is hereby granted without fee, provided that
+//  the above copyright notice appears in all copies and that both that
+//  copyright notice and this permission notice appear in supporting
+//  documentation.
+//
+//  There are no representations made about the suitability of this software
+//  for any purpose. It is provided "as is" without expressed or implied
+//  warranty.
+//
+//=============================================================================
+
+
+//=============================================================================
+//  dlSkipListTest
+//
+//  description:    differential test of CdlSkipList against std::multiset.
+//                  the elements are ordered by a key only and carry an id,
+//                  so the order of equal elements is checked as well: both
+//                  containers insert behind the equal elements. every run
+//                  uses another range of keys, from many duplicates to
+//                  nearly none. built with _DEBUG, every position passed
+//                  to the list is verified by IsValidPosition().
+//
+//  usage:          dlSkipListTest [-seed n] [-runs n] [-ops n]
+//=============================================================================
+
+#include "dlSkipList.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <set>
+
+
+//  reports a failed check and leaves the current run
+//
+#define DL_CHECK(expr)                                                  \
+    if (!(expr))                                                        \
+    {                                                                   \
+        fprintf(stderr, "line %d: check failed: %s\n", __LINE__, #expr); \
+        return false;                                                   \
+    }
+
+
+//  the element type, ordered by the key only
+//
+struct DL_ITEM
+{
+    long          nKey;
+    unsigned long nId;
+};
+
+struct DL_KEYLESS
+{
+    bool operator()(const DL_ITEM& left, const DL_ITEM& right) const
+    {
+        return static_cast<bool>(left.nKey < right.nKey);
+    }
+};
+
+typedef CdlSkipList<DL_ITEM, DL_KEYLESS>        CdlTestList;
+typedef std::multiset<DL_ITEM, DL_KEYLESS>      DL_MODEL;
+typedef std::map<unsigned long, DL_POSITION>    DL_POSITIONS;
+
+
+//  compares the element at a position with a model element
+//
+static bool IsAt(const CdlTestList& list, DL_POSITION position, const DL_MODEL& model, DL_MODEL::const_iterator it)
+{
+    DL_ITEM item;
+
+    if ( (0 == position) || (model.end() == it) )
+    {
+        return static_cast<bool>( (0 == position) && (model.end() == it) );
+    }
+
+    return static_cast<bool>( (true == list.GetAt(item, position))
+                           && (item.nKey == it->nKey)
+                           && (item.nId  == it->nId) );
+}
+
+
+//  walks the list in both directions and compares it with the model
+//
+static bool Verify(const CdlTestList& list, const DL_MODEL& model, const DL_POSITIONS& positions)
+{
+    DL_CHECK(list.GetCount() == model.size());
+    DL_CHECK(list.IsEmpty()  == model.empty());
+
+    DL_MODEL::const_iterator it       = model.begin();
+    DL_POSITION              position = list.GetFirstPosition();
+
+    for (; model.end() != it; ++it, position = list.GetNextPosition(position))
+    {
+        DL_CHECK(true == IsAt(list, position, model, it));
+        DL_CHECK(positions.find(it->nId)->second == position);
+    }
+
+    DL_CHECK(0 == position);
+
+    DL_MODEL::const_reverse_iterator rit = model.rbegin();
+    position = list.GetLastPosition();
+
+    for (; model.rend() != rit; ++rit, position = list.GetPreviousPosition(position))
+    {
+        DL_CHECK(true == IsAt(list, position, model, --rit.base()));
+    }
+
+    DL_CHECK(0 == position);
+
+    DL_ITEM item;
+    DL_CHECK(list.GetFirst(item) == !model.empty());
+    DL_CHECK(list.GetLast (item) == !model.empty());
+
+    return true;
+}
+
+
+//  one run of random operations on keys below 'nKeys'
+//
+static bool Run(unsigned long nSeed, unsigned long nOps)
+{
+    srand(static_cast<unsigned int>(nSeed));
+
+    static const long anKeys[] = { 4L, 64L, 4096L, 1000000L };
+
+    const long    nKeys = anKeys[nSeed % (sizeof(anKeys) / sizeof(anKeys[0]))];
+    CdlTestList   list;
+    DL_MODEL      model;
+    DL_POSITIONS  positions;
+    unsigned long nIds = 0L;
+
+    for (unsigned long nOp = 0; nOp < nOps; nOp++)
+    {
+        DL_ITEM item;
+
+        item.nKey = rand() % nKeys;
+        item.nId  = 0L;
+
+        switch (rand() % 16)
+        {
+            //  inserts mostly, so that the list grows
+            //
+            case 0:
+            case 1:
+            case 2:
+            case 3:
+            case 4:
+            case 5:
+            {
+                item.nId = ++nIds;
+
+                DL_POSITION position = list.Insert(item);
+
+                DL_CHECK(0 != position);
+                DL_CHECK(true == list.IsValidPosition(position));
+
+                positions[item.nId] = position;
+                DL_CHECK(true == IsAt(list, position, model, model.insert(item)));
+                break;
+            }
+
+            case 6:
+            case 7:
+                DL_CHECK(true == IsAt(list, list.LowerBound(item), model, model.lower_bound(item)));
+                DL_CHECK(true == IsAt(list, list.UpperBound(item), model, model.upper_bound(item)));
+                break;
+
+            //  deletes an element by its position, the neighbours
+            //  are checked by the next walk
+            //
+            case 8:
+            case 9:
+            {
+                if (true == positions.empty())
+                {
+                    DL_CHECK(false == list.DeleteAt(0));
+                    break;
+                }
+
+                DL_POSITIONS::iterator at = positions.lower_bound(1 + rand() % nIds);
+
+                if (positions.end() == at)
+                {
+                    at = positions.begin();
+                }
+
+                DL_CHECK(true == list.GetAt(item, at->second));
+                DL_CHECK(item.nId == at->first);
+
+                DL_MODEL::iterator it = model.lower_bound(item);
+
+                while (it->nId != item.nId)
+                {
+                    ++it;
+                }
+
+                DL_CHECK(true == list.DeleteAt(at->second));
+
+                model.erase(it);
+                positions.erase(at);
+                break;
+            }
+
+            case 10:
+                DL_CHECK(list.DeleteFirst() == !model.empty());
+
+                if (false == model.empty())
+                {
+                    positions.erase(model.begin()->nId);
+                    model.erase(model.begin());
+                }
+                break;
+
+            case 11:
+                DL_CHECK(list.DeleteLast() == !model.empty());
+
+                if (false == model.empty())
+                {
+                    positions.erase(model.rbegin()->nId);
+                    model.erase(--model.end());
+                }
+                break;
+
+            //  deletes a short range of keys
+            //
+            case 12:
+            {
+                DL_ITEM to = item;
+
+                to.nKey = item.nKey + rand() % (nKeys / 64 + 2) - 1;
+
+                DL_MODEL::iterator first = model.lower_bound(item);
+                DL_MODEL::iterator last  = (to.nKey > item.nKey) ? model.lower_bound(to) : first;
+                unsigned long      nCount = 0L;
+
+                for (DL_MODEL::iterator it = first; last != it; ++it, nCount++)
+                {
+                    positions.erase(it->nId);
+                }
+
+                DL_CHECK(nCount == list.DeleteRange(item, to));
+
+                model.erase(first, last);
+                break;
+            }
+
+            case 13:
+                if (0 == rand() % 64)
+                {
+                    list.DeleteAll();
+                    model.clear();
+                    positions.clear();
+                }
+                break;
+
+            default:
+                DL_CHECK(true == Verify(list, model, positions));
+                break;
+        }
+    }
+
+    return Verify(list, model, positions);
+}
+
+
+int main(int argc, char* argv[])
+{
+    unsigned long nSeed = 1L;
+    unsigned long nRuns = 40L;
+    unsigned long nOps  = 4000L;
+
+    for (int nArg = 1; nArg + 1 < argc; nArg += 2)
+    {
+        const unsigned long nValue = strtoul(argv[nArg + 1], 0, 10);
+
+        if      (0 == strcmp(argv[nArg], "-seed")) nSeed = nValue;
+        else if (0 == strcmp(argv[nArg], "-runs")) nRuns = nValue;
+        else if (0 == strcmp(argv[nArg], "-ops"))  nOps  = nValue;
+
+        else
+        {
+            fprintf(stderr, "unknown option '%s'\n", argv[nArg]);
+            return 1;
+        }
+    }
+
+    for (unsigned long nRun = 0; nRun < nRuns; nRun++, nSeed++)
+    {
+        if (false == Run(nSeed, nOps))
+        {
+            fprintf(stderr, "seed %lu failed\n", nSeed);
+            return 1;
+        }
+    }
+
+    printf("%lu runs of %lu operations passed\n", nRuns, nOps);
+
+    return 0;
+}
+
+//  end of file
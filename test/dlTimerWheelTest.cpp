@@ -0,0 +1,270 @@
+//=============================================================================
+//
+//  Copyright (c) 2004. Riccardo Riedl (www.riccardo-riedl.de)
+//
+//  Permission to use, copy, modify, distribute and sell this software and its
+//  documentation for any purpose is hereby granted without fee, provided that
+//  the above copyright notice appears in all copies and that both that
+//  copyright notice and this permission notice appear in supporting
+//  documentation.
+//
+//  There are no representations made about the suitability of this software
+//  for any purpose. It is provided "as is" without expressed or implied
+//  warranty.
+//
+//=============================================================================
+
+
+//=============================================================================
+//  dlTimerWheelTest
+//
+//  description:    randomized test of CdlTimerWheel against a model kept in
+//                  std::map. timers are scheduled with delays from one tick
+//                  up to 'maxdelay', in the past, cancelled before and after
+//                  they expired, and the time is advanced in steps of one
+//                  tick up to 1/32 of 'maxdelay'. after every Advance()
+//                  exactly the timers due in the model must have expired,
+//                  at their positions. with DL_WHEEL_BITS and DL_WHEEL_LEVELS
+//                  defined small, the delays go beyond the range of the
+//                  wheel and the timers are placed again when they cascade.
+//
+//  usage:          dlTimerWheelTest [-seed n] [-runs n] [-steps n]
+//                                   [-maxdelay bits]
+//=============================================================================
+
+#include "dlTimerWheel.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <set>
+#include <utility>
+
+
+//  reports a failed check and leaves the current run
+//
+#define DL_CHECK(expr)                                                  \
+    if (!(expr))                                                        \
+    {                                                                   \
+        fprintf(stderr, "line %d: check failed: %s\n", __LINE__, #expr); \
+        return false;                                                   \
+    }
+
+typedef CdlTimerWheel<long>         CdlTestWheel;
+typedef CdlTestWheel::CdlTimerList  CdlTestTimerList;
+
+
+//  a scheduled timer of the model
+//
+struct DL_MODELTIMER
+{
+    unsigned long nDue;         //  the tick it has to expire with
+    DL_POSITION   position;     //  returned by Schedule()
+};
+
+typedef std::map<long, DL_MODELTIMER>                   DL_MODELTIMERS;
+typedef std::set< std::pair<unsigned long, long> >      DL_MODELDUE;
+
+
+//  returns a random number, that is below 2^nBits. the number of bits is
+//  drawn first, so short and long delays are equally frequent.
+//
+static unsigned long Random(unsigned long nBits)
+{
+    unsigned long nValue = (static_cast<unsigned long>(rand()) << 16) ^ static_cast<unsigned long>(rand());
+    unsigned long nWidth = static_cast<unsigned long>(rand()) % (nBits + 1);
+
+    return (0L == nWidth) ? 0L : nValue & ((1UL << nWidth) - 1);
+}
+
+
+//  one run of the wheel against the model
+//
+static bool Run(unsigned long nSeed, unsigned long nSteps, unsigned long nMaxBits)
+{
+    srand(static_cast<unsigned int>(nSeed));
+
+    //  the wheel starts at some time, so that the levels do not all start
+    //  at slot 0 and timers can be scheduled in the past
+    //
+    CdlTestWheel     wheel(Random(24));
+    CdlTestTimerList expired;
+    DL_MODELTIMERS   timers;
+    DL_MODELDUE      due;
+    long             nIds = 0L;
+
+    for (unsigned long nStep = 0; nStep < nSteps; nStep++)
+    {
+        const unsigned long nNext = wheel.GetTime();
+
+        switch (rand() % 10)
+        {
+            //  schedules a timer, some of them in the past
+            //
+            case 0:
+            case 1:
+            case 2:
+            case 3:
+            {
+                unsigned long nExpiry = nNext + Random(nMaxBits);
+                unsigned long nShift  = DL_WHEEL_BITS * (1 + rand() % DL_WHEEL_LEVELS);
+
+                //  delays around the range of a level, which are
+                //  the first ones to go to the next level up
+                //
+                if ( (0 == rand() % 8) && (nShift <= nMaxBits) )
+                {
+                    nExpiry = nNext + (1UL << nShift) - 1 + rand() % 3;
+                }
+
+                else if (0 == rand() % 16)
+                {
+                    nExpiry = nNext - Random(8);
+                }
+
+                DL_MODELTIMER timer;
+
+                timer.nDue     = (nExpiry < nNext) ? nNext : nExpiry;
+                timer.position = wheel.Schedule(++nIds, nExpiry);
+
+                DL_CHECK(0 != timer.position);
+
+                timers[nIds] = timer;
+                due.insert(std::make_pair(timer.nDue, nIds));
+                break;
+            }
+
+            //  cancels a scheduled timer
+            //
+            case 4:
+            case 5:
+            {
+                if (true == timers.empty())
+                {
+                    DL_CHECK(false == wheel.Cancel(0));
+                    break;
+                }
+
+                DL_MODELTIMERS::iterator it = timers.lower_bound(1 + rand() % nIds);
+
+                if (timers.end() == it)
+                {
+                    it = timers.begin();
+                }
+
+                DL_CHECK(true == wheel.Cancel(it->second.position));
+
+                due.erase(std::make_pair(it->second.nDue, it->first));
+                timers.erase(it);
+                break;
+            }
+
+            //  cancelling an expired timer must fail and leave
+            //  it in the list passed to Advance()
+            //
+            case 6:
+            {
+                DL_POSITION position = expired.GetFirstPosition();
+
+                for (int nSkip = rand() % 8; (0 != position) && (nSkip > 0); nSkip--)
+                {
+                    position = expired.GetNextPosition(position);
+                }
+
+                if (0 != position)
+                {
+                    const unsigned long nCount = expired.GetCount();
+
+                    DL_CHECK(false  == wheel.Cancel(position));
+                    DL_CHECK(nCount == expired.GetCount());
+                    DL_CHECK(true   == expired.IsValidPosition(position));
+                }
+
+                break;
+            }
+
+            //  advances the time and compares the expired timers
+            //  with the ones due in the model
+            //
+            default:
+            {
+                const unsigned long nNow = nNext - 1 + ( (0 == rand() % 4) ? 1 : Random(nMaxBits - 5) + 1 );
+
+                expired.DeleteAll();
+
+                const unsigned long nExpired = wheel.Advance(nNow, expired);
+
+                DL_CHECK(nNow + 1 == wheel.GetTime());
+                DL_CHECK(nExpired == expired.GetCount());
+
+                for (DL_POSITION position = expired.GetFirstPosition(); 0 != position; position = expired.GetNextPosition(position))
+                {
+                    const long               nId = CdlTestTimerList::ElementAt(position).data;
+                    DL_MODELTIMERS::iterator it  = timers.find(nId);
+
+                    DL_CHECK(timers.end() != it);
+                    DL_CHECK(it->second.nDue <= nNow);
+                    DL_CHECK(it->second.position == position);
+
+                    due.erase(std::make_pair(it->second.nDue, nId));
+                    timers.erase(it);
+                }
+
+                DL_CHECK( (true == due.empty()) || (due.begin()->first > nNow) );
+                break;
+            }
+        }
+
+        DL_CHECK(timers.size() == wheel.GetCount());
+    }
+
+    return true;
+}
+
+
+int main(int argc, char* argv[])
+{
+    unsigned long nSeed    = 1L;
+    unsigned long nRuns    = 20L;
+    unsigned long nSteps   = 4000L;
+    unsigned long nMaxBits = 26L;
+
+    for (int nArg = 1; nArg + 1 < argc; nArg += 2)
+    {
+        const unsigned long nValue = strtoul(argv[nArg + 1], 0, 10);
+
+        if      (0 == strcmp(argv[nArg], "-seed"))     nSeed    = nValue;
+        else if (0 == strcmp(argv[nArg], "-runs"))     nRuns    = nValue;
+        else if (0 == strcmp(argv[nArg], "-steps"))    nSteps   = nValue;
+        else if (0 == strcmp(argv[nArg], "-maxdelay")) nMaxBits = nValue;
+
+        else
+        {
+            fprintf(stderr, "unknown option '%s'\n", argv[nArg]);
+            return 1;
+        }
+    }
+
+    if ( (nMaxBits < 6) || (nMaxBits > 30) )
+    {
+        fprintf(stderr, "-maxdelay must be between 6 and 30 bits\n");
+        return 1;
+    }
+
+    for (unsigned long nRun = 0; nRun < nRuns; nRun++, nSeed++)
+    {
+        if (false == Run(nSeed, nSteps, nMaxBits))
+        {
+            fprintf(stderr, "seed %lu failed\n", nSeed);
+            return 1;
+        }
+    }
+
+    printf("%lu runs of %lu steps with delays up to 2^%lu ticks on %d levels of %d bits passed\n",
+           nRuns, nSteps, nMaxBits, DL_WHEEL_LEVELS, DL_WHEEL_BITS);
+
+    return 0;
+}
+
+//  end of file